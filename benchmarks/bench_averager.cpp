@@ -0,0 +1,16 @@
+#include <config.h>
+#include <radio/averager.h>
+
+#include "bench_helpers.h"
+
+static void BM_AveragerPush(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto data = generatePower(size);
+  Averager averager(size, GROUPING_Y);
+  for (auto _ : state) {
+    averager.push(data.data());
+    benchmark::DoNotOptimize(averager.average().data());
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_AveragerPush)->BENCHMARK_FFT_SIZES;
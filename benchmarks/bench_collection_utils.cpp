@@ -0,0 +1,32 @@
+#include <config.h>
+#include <utils/collection_utils.h>
+
+#include "bench_helpers.h"
+
+static void BM_GetMaxIndex(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto data = generatePower(size);
+  const auto groupSize = std::max(1, static_cast<int>(size / (BENCHMARK_SAMPLE_RATE / 32000)));
+  for (auto _ : state) {
+    for (int index = 0; index < size; index += groupSize) {
+      benchmark::DoNotOptimize(getMaxIndex(data.data(), size, index, groupSize));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_GetMaxIndex)->BENCHMARK_FFT_SIZES;
+
+static void BM_MostFrequentValue(benchmark::State& state) {
+  const auto size = state.range(0);
+  std::mt19937 generator(size);
+  std::normal_distribution<float> distribution(size / 2, GROUPING_X);
+  std::vector<int> data(GROUPING_Y);
+  for (auto& value : data) {
+    value = static_cast<int>(distribution(generator));
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mostFrequentValue(data));
+  }
+  state.SetItemsProcessed(state.iterations() * data.size());
+}
+BENCHMARK(BM_MostFrequentValue)->BENCHMARK_FFT_SIZES;
@@ -0,0 +1,36 @@
+#include <network/data_controller.h>
+
+#include "bench_helpers.h"
+
+static void BM_TransmissionPayload(benchmark::State& state) {
+  const auto size = state.range(0);
+  const std::vector<DataController::TransmissionData> data(size, {12, -34});
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DataController::getTransmissionPayload(std::chrono::milliseconds(0), BENCHMARK_FREQUENCY, 32000, data.data(), size));
+  }
+  state.SetBytesProcessed(state.iterations() * size * sizeof(DataController::TransmissionData));
+}
+BENCHMARK(BM_TransmissionPayload)->BENCHMARK_FFT_SIZES;
+
+static void BM_TransmissionPayloadPooled(benchmark::State& state) {
+  const auto size = state.range(0);
+  const std::vector<DataController::TransmissionData> data(size, {12, -34});
+  PayloadPool pool(PAYLOAD_POOL_SIZE);
+  for (auto _ : state) {
+    auto payload = pool.get(DataController::getTransmissionPayloadSize(size));
+    DataController::setTransmissionPayload(reinterpret_cast<uint8_t*>(payload->data()), std::chrono::milliseconds(0), BENCHMARK_FREQUENCY, 32000, data.data(), size);
+    benchmark::DoNotOptimize(payload->data());
+  }
+  state.SetBytesProcessed(state.iterations() * size * sizeof(DataController::TransmissionData));
+}
+BENCHMARK(BM_TransmissionPayloadPooled)->BENCHMARK_FFT_SIZES;
+
+static void BM_SpectrogramPayload(benchmark::State& state) {
+  const auto size = state.range(0);
+  const std::vector<DataController::SpectrogramData> data(size, -80);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DataController::getSpectrogramPayload(std::chrono::milliseconds(0), BENCHMARK_FREQUENCY, BENCHMARK_SAMPLE_RATE, data.data(), size));
+  }
+  state.SetBytesProcessed(state.iterations() * size * sizeof(DataController::SpectrogramData));
+}
+BENCHMARK(BM_SpectrogramPayload)->BENCHMARK_FFT_SIZES;
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <config.h>
+#include <network/mqtt.h>
+
+#include <complex>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <vector>
+
+constexpr auto BENCHMARK_SAMPLE_RATE = 20480000;
+constexpr auto BENCHMARK_FREQUENCY = 145000000;
+constexpr auto BENCHMARK_MIN_FFT = 4096;
+constexpr auto BENCHMARK_MAX_FFT = 262144;
+
+#define BENCHMARK_FFT_SIZES RangeMultiplier(4)->Range(BENCHMARK_MIN_FFT, BENCHMARK_MAX_FFT)
+
+inline std::vector<float> generatePower(const int size, const float noise = -80.0f) {
+  std::mt19937 generator(size);
+  std::normal_distribution<float> distribution(noise, 3.0f);
+  std::vector<float> data(size);
+  for (auto& value : data) {
+    value = distribution(generator);
+  }
+  return data;
+}
+
+inline std::vector<std::complex<float>> generateIq(const int size) {
+  std::mt19937 generator(size);
+  std::normal_distribution<float> distribution(0.0f, 0.1f);
+  std::vector<std::complex<float>> data(size);
+  for (auto& value : data) {
+    value = {distribution(generator), distribution(generator)};
+  }
+  return data;
+}
+
+inline const Config& getBenchmarkConfig() {
+  static const Config config = []() {
+    setenv("MQTT_URL", "tcp://127.0.0.1:1", 0);
+    setenv("MQTT_USER", "", 0);
+    setenv("MQTT_PASSWORD", "", 0);
+    return Config::loadFromJson(nlohmann::json::parse(R"({
+      "devices": [],
+      "ignored_frequencies": [],
+      "output": {"color_log_enabled": false, "console_log_level": "off", "file_log_level": "off"},
+      "recording": {"max_noise_time_ms": 2000, "min_sample_rate": 32000, "min_time_ms": 2000, "step": 2500},
+      "version": 1,
+      "workers": 0
+    })"));
+  }();
+  return config;
+}
+
+inline Mqtt& getBenchmarkMqtt() {
+  static Mqtt mqtt(getBenchmarkConfig());
+  return mqtt;
+}
@@ -0,0 +1,22 @@
+#include <benchmark/benchmark.h>
+#include <logger.h>
+
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv) {
+  Logger::configure(spdlog::level::off, spdlog::level::off, "", 0, 0, true, LogMode::Sync, 0, {});
+
+  std::string format = "--benchmark_format=json";
+  std::vector<char*> args{argv[0], format.data()};
+  args.insert(args.end(), argv + 1, argv + argc);
+  int size = args.size();
+
+  benchmark::Initialize(&size, args.data());
+  if (benchmark::ReportUnrecognizedArguments(size, args.data())) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,25 @@
+#include <config.h>
+#include <radio/blocks/noise_learner.h>
+
+#include "bench_helpers.h"
+
+static void BM_NoiseLearnerWork(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto input = generatePower(size);
+  std::vector<float> output(size);
+  gr_vector_const_void_star inputItems{input.data()};
+  gr_vector_void_star outputItems{output.data()};
+  NoiseLearner noiseLearner(size, []() { return BENCHMARK_FREQUENCY; }, [](const int index) { return BENCHMARK_FREQUENCY + index; }, nullptr, {});
+
+  // finish warmup before measuring steady state processing
+  for (int i = 0; i < NOISE_TRACKING_WARMUP; ++i) {
+    noiseLearner.work(1, inputItems, outputItems);
+  }
+
+  for (auto _ : state) {
+    noiseLearner.work(1, inputItems, outputItems);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_NoiseLearnerWork)->BENCHMARK_FFT_SIZES->Unit(benchmark::kMicrosecond);
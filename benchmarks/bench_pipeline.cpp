@@ -0,0 +1,197 @@
+#include <dirent.h>
+#include <scanner.h>
+#include <unistd.h>
+#include <utils/radio_utils.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#include "bench_helpers.h"
+#include "synthetic_source.h"
+
+constexpr auto PIPELINE_NOISE_AMPLITUDE = 0.01f;
+constexpr auto PIPELINE_TONE_AMPLITUDE = 0.05f;
+constexpr auto PIPELINE_BURST_AMPLITUDE = 0.1f;
+constexpr auto PIPELINE_BURSTS_WINDOW = std::chrono::seconds(4);
+constexpr auto PIPELINE_TAIL = std::chrono::seconds(3);
+constexpr auto PIPELINE_MIN_BURST = std::chrono::milliseconds(500);
+constexpr auto PIPELINE_MAX_BURST = std::chrono::milliseconds(2000);
+
+namespace {
+// noise learning is done on clean noise plus tones, bursts start after it
+std::vector<SyntheticSignal> generateScene(const Config& config, const Frequency sampleRate, const int signalsCount) {
+  const auto toSamples = [sampleRate](const std::chrono::milliseconds time) { return static_cast<uint64_t>(time.count()) * sampleRate / 1000; };
+  const auto learningTime = INITIAL_DELAY + std::chrono::milliseconds(3000);
+  const auto spacing = 2 * config.recordingBandwidth();
+  const auto channels = static_cast<int>(0.9 * sampleRate / spacing);
+
+  std::mt19937 generator(signalsCount);
+  std::vector<int> indexes(channels);
+  std::iota(indexes.begin(), indexes.end(), -channels / 2);
+  std::shuffle(indexes.begin(), indexes.end(), generator);
+  std::uniform_int_distribution<int> startDistribution(0, PIPELINE_BURSTS_WINDOW.count() * 1000);
+  std::uniform_int_distribution<int> durationDistribution(PIPELINE_MIN_BURST.count(), PIPELINE_MAX_BURST.count());
+
+  std::vector<SyntheticSignal> signals;
+  for (int i = 0; i < std::min(signalsCount, channels); ++i) {
+    const auto shift = indexes[i] * spacing + spacing / 2;
+    if (i % 2) {
+      signals.push_back({shift, PIPELINE_TONE_AMPLITUDE, false, 0, std::numeric_limits<uint64_t>::max()});
+    } else {
+      const auto start = learningTime + std::chrono::milliseconds(startDistribution(generator));
+      const auto stop = start + std::chrono::milliseconds(durationDistribution(generator));
+      signals.push_back({shift, PIPELINE_BURST_AMPLITUDE, true, toSamples(start), toSamples(stop)});
+    }
+  }
+  return signals;
+}
+
+// cpu time in seconds per thread name, gnuradio names block threads after blocks
+std::map<std::string, double> getThreadsCpuTime() {
+  std::map<std::string, double> times;
+  const auto ticks = static_cast<double>(sysconf(_SC_CLK_TCK));
+  auto dir = opendir("/proc/self/task");
+  if (!dir) {
+    return times;
+  }
+  while (auto entry = readdir(dir)) {
+    if (entry->d_name[0] == '.') {
+      continue;
+    }
+    const auto path = std::string("/proc/self/task/") + entry->d_name;
+    std::string name;
+    std::getline(std::ifstream(path + "/comm"), name);
+    std::string stat;
+    std::getline(std::ifstream(path + "/stat"), stat);
+    const auto position = stat.rfind(')');
+    if (name.empty() || position == std::string::npos) {
+      continue;
+    }
+    // fields after comm: state is 3rd, utime and stime are 14th and 15th
+    std::istringstream stream(stat.substr(position + 2));
+    std::string field;
+    uint64_t utime = 0, stime = 0;
+    for (int i = 3; i <= 15 && stream >> field; ++i) {
+      if (i == 14) utime = std::stoull(field);
+      if (i == 15) stime = std::stoull(field);
+    }
+    name.erase(std::find_if(name.rbegin(), name.rend(), [](char c) { return !std::isdigit(c); }).base(), name.end());
+    times[name] += (utime + stime) / ticks;
+  }
+  closedir(dir);
+  return times;
+}
+}  // namespace
+
+static void BM_Pipeline(benchmark::State& state) {
+  const auto sampleRate = static_cast<Frequency>(state.range(0));
+  const auto signalsCount = static_cast<int>(state.range(1));
+  const auto realTime = state.range(2) != 0;
+  const auto& config = getBenchmarkConfig();
+
+  Device device;
+  device.m_enabled = true;
+  device.m_driver = "synthetic";
+  device.m_serial = "bench";
+  device.m_sampleRate = sampleRate;
+  device.m_ranges = {{BENCHMARK_FREQUENCY - getRangeSplitSampleRate(sampleRate) / 2, BENCHMARK_FREQUENCY + getRangeSplitSampleRate(sampleRate) / 2}};
+  device.m_startLevel = DEFAULT_RECORDING_START_LEVEL;
+  device.m_stopLevel = DEFAULT_RECORDING_STOP_LEVEL;
+
+  const auto signals = generateScene(config, sampleRate, signalsCount);
+  uint64_t lastSample = 0;
+  for (const auto& signal : signals) {
+    if (signal.m_isFm) lastSample = std::max(lastSample, signal.m_stop);
+  }
+
+  for (auto _ : state) {
+    const auto source = std::make_shared<SyntheticSource>(sampleRate, PIPELINE_NOISE_AMPLITUDE, signals, realTime);
+    std::mutex mutex;
+    std::map<int, std::chrono::steady_clock::time_point> firstDetections;
+    std::map<int, std::set<Frequency>> detectedFrequencies;
+    uint64_t falseDetections = 0;
+
+    Mqtt mqtt(config);
+    const auto topic = fmt::format("sdr/{}/transmission/uint8", device.getName());
+    mqtt.setPublishCallback([&](const std::string& publishTopic, const std::string& data) {
+      if (publishTopic != topic || data.size() < sizeof(uint64_t) + 2 * sizeof(Frequency)) {
+        return;
+      }
+      const auto now = std::chrono::steady_clock::now();
+      Frequency start, stop;
+      std::memcpy(&start, data.data() + sizeof(uint64_t), sizeof(Frequency));
+      std::memcpy(&stop, data.data() + sizeof(uint64_t) + sizeof(Frequency), sizeof(Frequency));
+      const auto frequency = (start + stop) / 2;
+      const auto sample = source->produced();
+      std::unique_lock lock(mutex);
+      for (size_t i = 0; i < signals.size(); ++i) {
+        const auto& signal = signals[i];
+        if (std::abs(BENCHMARK_FREQUENCY + signal.m_shift - frequency) <= config.recordingBandwidth() && signal.m_start <= sample) {
+          firstDetections.try_emplace(i, now);
+          detectedFrequencies[i].insert(frequency);
+          return;
+        }
+      }
+      falseDetections++;
+    });
+
+    const auto startCpu = getThreadsCpuTime();
+    const auto startTime = std::chrono::steady_clock::now();
+    {
+      Scanner scanner(config, device, mqtt, config.recordersCount(), source);
+      while (source->produced() == 0) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      const auto endTime = realTime ? source->getTime(lastSample) + PIPELINE_TAIL : startTime + PIPELINE_BURSTS_WINDOW + PIPELINE_TAIL;
+      std::this_thread::sleep_until(endTime);
+      mqtt.setPublishCallback(nullptr);
+    }
+    const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    const auto samples = static_cast<double>(source->produced());
+    state.counters["samples_per_second"] = samples / duration;
+    state.counters["realtime_factor"] = samples / duration / sampleRate;
+    for (const auto& [name, time] : getThreadsCpuTime()) {
+      const auto it = startCpu.find(name);
+      const auto cpu = time - (it == startCpu.end() ? 0.0 : it->second);
+      if (0.0 < cpu) {
+        state.counters["cpu_ns_per_sample/" + name] = cpu * 1e9 / samples;
+      }
+    }
+
+    if (realTime) {
+      int bursts = 0, missed = 0, duplicates = 0;
+      double latencySum = 0.0, latencyMax = 0.0;
+      for (size_t i = 0; i < signals.size(); ++i) {
+        if (!signals[i].m_isFm) {
+          continue;
+        }
+        bursts++;
+        const auto it = firstDetections.find(i);
+        if (it == firstDetections.end()) {
+          missed++;
+          continue;
+        }
+        const auto latency = std::chrono::duration<double, std::milli>(it->second - source->getTime(signals[i].m_start)).count();
+        latencySum += latency;
+        latencyMax = std::max(latencyMax, latency);
+        duplicates += detectedFrequencies[i].size() - 1;
+      }
+      state.counters["bursts"] = bursts;
+      state.counters["missed"] = missed;
+      state.counters["duplicates"] = duplicates;
+      state.counters["false_detections"] = falseDetections;
+      state.counters["latency_avg_ms"] = bursts == missed ? 0.0 : latencySum / (bursts - missed);
+      state.counters["latency_max_ms"] = latencyMax;
+    }
+  }
+}
+// {sample rate, signals, real time}, detection metrics are reported only in real time mode
+BENCHMARK(BM_Pipeline)->Args({2048000, 8, 1})->Args({20480000, 64, 1})->Args({20480000, 256, 0})->Iterations(1)->UseRealTime()->Unit(benchmark::kSecond);
@@ -0,0 +1,18 @@
+#include <radio/blocks/psd.h>
+
+#include "bench_helpers.h"
+
+static void BM_PsdWork(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto input = generateIq(size);
+  std::vector<float> output(size);
+  gr_vector_const_void_star inputItems{input.data()};
+  gr_vector_void_star outputItems{output.data()};
+  PSD psd(size, BENCHMARK_SAMPLE_RATE, "benchmark");
+  for (auto _ : state) {
+    psd.work(1, inputItems, outputItems);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_PsdWork)->BENCHMARK_FFT_SIZES;
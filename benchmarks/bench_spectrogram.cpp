@@ -0,0 +1,17 @@
+#include <radio/blocks/spectrogram.h>
+
+#include "bench_helpers.h"
+
+static void BM_SpectrogramWork(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto input = generatePower(size);
+  gr_vector_const_void_star inputItems{input.data()};
+  gr_vector_void_star outputItems;
+  DataController dataController(getBenchmarkMqtt(), "benchmark");
+  Spectrogram spectrogram(size, BENCHMARK_SAMPLE_RATE, dataController, []() { return BENCHMARK_FREQUENCY; });
+  for (auto _ : state) {
+    spectrogram.work(1, inputItems, outputItems);
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_SpectrogramWork)->BENCHMARK_FFT_SIZES->Unit(benchmark::kMicrosecond);
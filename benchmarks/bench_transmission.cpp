@@ -0,0 +1,30 @@
+#include <radio/blocks/transmission.h>
+
+#include "bench_helpers.h"
+
+static void BM_TransmissionWork(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto step = static_cast<double>(BENCHMARK_SAMPLE_RATE) / size;
+  const auto groupSize = static_cast<int>(std::ceil(getBenchmarkConfig().recordingBandwidth() / step));
+  auto input = generatePower(size, 0.0f);
+  for (int i = 1; i <= 4; ++i) {
+    for (int j = 0; j < groupSize; ++j) {
+      input[i * size / 5 + j] = 20.0f;
+    }
+  }
+  gr_vector_const_void_star inputItems{input.data()};
+  gr_vector_void_star outputItems;
+
+  Device device;
+  device.m_startLevel = DEFAULT_RECORDING_START_LEVEL;
+  device.m_stopLevel = DEFAULT_RECORDING_STOP_LEVEL;
+  const Snapshot<ScanSettings> settings(std::make_shared<const ScanSettings>(getBenchmarkConfig().scanSettings(device)));
+  TransmissionNotification notification;
+  Transmission transmission(getBenchmarkConfig(), device, settings, size, groupSize, BENCHMARK_SAMPLE_RATE, notification);
+  transmission.setFrequencyRange({BENCHMARK_FREQUENCY - BENCHMARK_SAMPLE_RATE / 2, BENCHMARK_FREQUENCY + BENCHMARK_SAMPLE_RATE / 2});
+  for (auto _ : state) {
+    transmission.work(1, inputItems, outputItems);
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_TransmissionWork)->BENCHMARK_FFT_SIZES->Unit(benchmark::kMicrosecond);
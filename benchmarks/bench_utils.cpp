@@ -0,0 +1,16 @@
+#include <config.h>
+#include <utils/utils.h>
+
+#include "bench_helpers.h"
+
+static void BM_Average(benchmark::State& state) {
+  const auto size = state.range(0);
+  const auto input = generatePower(size);
+  std::vector<float> output(size);
+  for (auto _ : state) {
+    average(input.data(), output.data(), size, GROUPING_X);
+    benchmark::DoNotOptimize(output.data());
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_Average)->BENCHMARK_FFT_SIZES;
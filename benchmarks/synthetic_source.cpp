@@ -0,0 +1,95 @@
+#include "synthetic_source.h"
+
+#include <cmath>
+#include <random>
+#include <thread>
+
+constexpr auto NOISE_TABLE_SIZE = 1 << 20;
+constexpr auto FM_DEVIATION = 5000.0f;
+constexpr auto FM_MODULATION_FREQUENCY = 1000;
+constexpr auto MAX_OUTPUT_DURATION_MS = 10;
+
+SyntheticSource::SyntheticSource(const Frequency sampleRate, const float noiseAmplitude, const std::vector<SyntheticSignal>& signals, const bool realTime)
+    : gr::sync_block("SyntheticSource", gr::io_signature::make(0, 0, 0), gr::io_signature::make(1, 1, sizeof(gr_complex))),
+      Source(SampleFormat::CF32),
+      m_sampleRate(sampleRate),
+      m_realTime(realTime),
+      m_signals(signals),
+      m_noise(NOISE_TABLE_SIZE),
+      m_fmIncrements(sampleRate / FM_MODULATION_FREQUENCY),
+      m_phases(signals.size(), 1.0f),
+      m_noiseOffset(0),
+      m_produced(0) {
+  std::mt19937 generator(0);
+  std::normal_distribution<float> distribution(0.0f, noiseAmplitude / std::sqrt(2.0f));
+  for (auto& value : m_noise) {
+    value = {distribution(generator), distribution(generator)};
+  }
+  for (size_t i = 0; i < m_fmIncrements.size(); ++i) {
+    const auto deviation = FM_DEVIATION * std::sin(2.0f * M_PI * i / m_fmIncrements.size());
+    m_fmIncrements[i] = std::polar(1.0f, static_cast<float>(2.0f * M_PI * deviation / m_sampleRate));
+  }
+  for (const auto& signal : m_signals) {
+    m_increments.push_back(std::polar(1.0f, static_cast<float>(2.0f * M_PI * signal.m_shift / m_sampleRate)));
+  }
+  set_max_noutput_items(std::max(1024, static_cast<int>(m_sampleRate / 1000 * MAX_OUTPUT_DURATION_MS)));
+}
+
+int SyntheticSource::work(int noutput_items, gr_vector_const_void_star&, gr_vector_void_star& output_items) {
+  gr_complex* out = static_cast<gr_complex*>(output_items[0]);
+  addRetuneTag();
+  const auto begin = m_produced.load();
+  const auto end = begin + noutput_items;
+
+  for (int i = 0; i < noutput_items;) {
+    const auto offset = m_noiseOffset % NOISE_TABLE_SIZE;
+    const auto count = std::min<uint64_t>(noutput_items - i, NOISE_TABLE_SIZE - offset);
+    std::copy(m_noise.begin() + offset, m_noise.begin() + offset + count, out + i);
+    // odd step keeps consecutive blocks from repeating the same noise
+    m_noiseOffset += count + 7919;
+    i += count;
+  }
+
+  for (size_t j = 0; j < m_signals.size(); ++j) {
+    const auto& signal = m_signals[j];
+    if (end <= signal.m_start || signal.m_stop <= begin) {
+      continue;
+    }
+    const auto first = static_cast<int>(std::max(begin, signal.m_start) - begin);
+    const auto last = static_cast<int>(std::min(end, signal.m_stop) - begin);
+    auto phase = m_phases[j];
+    const auto increment = m_increments[j];
+    if (signal.m_isFm) {
+      const auto size = m_fmIncrements.size();
+      for (int i = first; i < last; ++i) {
+        phase *= increment * m_fmIncrements[(begin + i) % size];
+        out[i] += signal.m_amplitude * phase;
+      }
+    } else {
+      for (int i = first; i < last; ++i) {
+        phase *= increment;
+        out[i] += signal.m_amplitude * phase;
+      }
+    }
+    m_phases[j] = phase / std::abs(phase);
+  }
+
+  m_produced.store(end);
+  if (m_realTime) {
+    std::this_thread::sleep_until(getTime(end));
+  }
+  return noutput_items;
+}
+
+bool SyntheticSource::start() {
+  m_startTime = std::chrono::steady_clock::now();
+  return true;
+}
+
+bool SyntheticSource::setCenterFrequency(Frequency) { return true; }
+
+uint64_t SyntheticSource::produced() const { return m_produced.load(); }
+
+std::chrono::steady_clock::time_point SyntheticSource::getTime(const uint64_t sample) const {
+  return m_startTime + std::chrono::microseconds(static_cast<uint64_t>(sample * 1e6 / m_sampleRate));
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <radio/blocks/source.h>
+#include <radio/help_structures.h>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+struct SyntheticSignal {
+  Frequency m_shift;
+  float m_amplitude;
+  bool m_isFm;
+  uint64_t m_start;  // first sample
+  uint64_t m_stop;   // last sample, exclusive
+};
+
+// synthetic iq: gaussian noise plus tones and fm bursts, optionally paced to real time
+class SyntheticSource : public Source {
+ public:
+  SyntheticSource(const Frequency sampleRate, const float noiseAmplitude, const std::vector<SyntheticSignal>& signals, const bool realTime);
+
+  int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+  bool start() override;
+  bool setCenterFrequency(Frequency frequency) override;
+
+  uint64_t produced() const;
+  std::chrono::steady_clock::time_point getTime(const uint64_t sample) const;
+
+ private:
+  const Frequency m_sampleRate;
+  const bool m_realTime;
+  const std::vector<SyntheticSignal> m_signals;
+  std::vector<gr_complex> m_noise;
+  std::vector<gr_complex> m_fmIncrements;
+  std::vector<gr_complex> m_increments;
+  std::vector<gr_complex> m_phases;
+  uint64_t m_noiseOffset;
+  std::atomic<uint64_t> m_produced;
+  std::chrono::steady_clock::time_point m_startTime;
+};
@@ -3,8 +3,11 @@
 #include <config_migrator.h>
 #include <logger.h>
 #include <radio/sdr_device_reader.h>
+#include <utils/thread_utils.h>
 #include <utils/utils.h>
 
+#include <tuple>
+
 constexpr auto LABEL = "config";
 
 spdlog::level::level_enum parseLogLevel(const std::string& level) {
@@ -23,6 +26,16 @@ spdlog::level::level_enum parseLogLevel(const std::string& level) {
   return spdlog::level::level_enum::off;
 }
 
+LogMode parseLogMode(const std::string& mode) {
+  if (mode == "off")
+    return LogMode::Sync;
+  else if (mode == "block")
+    return LogMode::AsyncBlock;
+  else if (mode == "drop_oldest")
+    return LogMode::AsyncDropOldest;
+  throw std::runtime_error(fmt::format("invalid async log mode: {}", mode));
+}
+
 std::string getEnv(const std::string& key) {
   const auto value = std::getenv(key.c_str());
   if (value) {
@@ -69,18 +82,77 @@ std::vector<FrequencyRange> readIgnoredRanges(const nlohmann::json& json) {
   }
 }
 
+std::chrono::milliseconds readMinDwell(const nlohmann::json& json) {
+  const auto dwell = std::chrono::milliseconds(readKey<int>(json, {"scanning", "min_dwell_ms"}));
+  // no frame is detected before retune settle window ends
+  if (dwell <= RETUNE_SETTLE_TIME) {
+    throw std::runtime_error(fmt::format("invalid value in json: scanning.min_dwell_ms, must be greater than retune settle time: {} ms", RETUNE_SETTLE_TIME.count()));
+  }
+  return dwell;
+}
+
+int readLogQueueSize(const nlohmann::json& json) {
+  const auto size = readKey<int>(json, {"output", "async_log_queue_size"});
+  // empty queue would drop or block on every message
+  if (parseLogMode(json.at("output").at("async_log_mode").get<std::string>()) != LogMode::Sync && size <= 0) {
+    throw std::runtime_error("invalid value in json: output.async_log_queue_size, must be greater than 0");
+  }
+  return size;
+}
+
+int readDetectionFps(const nlohmann::json& json) {
+  const auto fps = readKey<int>(json, {"detection", "fps"});
+  // decimator factor is derived from step / fps
+  if (fps <= 0) {
+    throw std::runtime_error("invalid value in json: detection.fps, must be greater than 0");
+  }
+  return fps;
+}
+
+std::chrono::milliseconds readPreTrigger(const nlohmann::json& json) {
+  const auto preTrigger = std::chrono::milliseconds(readKey<int>(json, {"recording", "pre_trigger_ms"}));
+  // backfill is pushed to recorder buffer at once, it must fit together with live data received until next flush
+  const auto maxPreTrigger = (RECORDER_BUFFER_SIZE - 2) * RECORDER_FLUSH_INTERVAL;
+  if (preTrigger.count() < 0 || maxPreTrigger < preTrigger) {
+    throw std::runtime_error(fmt::format("invalid value in json: recording.pre_trigger_ms, must be in range: 0 - {} ms", maxPreTrigger.count()));
+  }
+  return preTrigger;
+}
+
+std::vector<int> readCores(const nlohmann::json& json, const std::string& section, const std::string& key) {
+  try {
+    const auto cores = json.at(section).at(key).get<std::vector<int>>();
+    Logger::info(LABEL, "read json variable, key: {}, value: {}", colored(GREEN, "{}.{}", section, key), colored(GREEN, "{}", formatCores(cores)));
+    return cores;
+  } catch (const std::exception& exception) {
+    throw std::runtime_error(fmt::format("key not found or invalid value in json: {}.{}", section, key));
+  }
+}
+
 Config::Config(const nlohmann::json& json)
     : m_json(json),
       m_devices(SdrDeviceReader::readDevices(json)),
       m_isColorLogEnabled(readKey<bool>(json, {"output", "color_log_enabled"})),
       m_consoleLogLevel(parseLogLevel(readKey<std::string>(json, {"output", "console_log_level"}))),
       m_fileLogLevel(parseLogLevel(readKey<std::string>(json, {"output", "file_log_level"}))),
+      m_logMode(parseLogMode(readKey<std::string>(json, {"output", "async_log_mode"}))),
+      m_logQueueSize(readLogQueueSize(json)),
+      m_detectionFps(readDetectionFps(json)),
       m_ignoredRanges(readIgnoredRanges(json)),
       m_recordingBandwidth(readKey<Frequency>(json, {"recording", "min_sample_rate"})),
       m_recordingMinTime(std::chrono::milliseconds(readKey<int>(json, {"recording", "min_time_ms"}))),
       m_recordingTimeout(std::chrono::milliseconds(readKey<int>(json, {"recording", "max_noise_time_ms"}))),
+      m_recordingPreTrigger(readPreTrigger(json)),
       m_recordingTuningStep(readKey<Frequency>(json, {"recording", "step"})),
+      m_scanningMinDwell(readMinDwell(json)),
+      m_scanningMaxDwell(std::chrono::milliseconds(readKey<int>(json, {"scanning", "max_dwell_ms"}))),
+      m_scanningMinRevisit(std::chrono::milliseconds(readKey<int>(json, {"scanning", "min_revisit_ms"}))),
+      m_scanningMaxRevisit(std::chrono::milliseconds(readKey<int>(json, {"scanning", "max_revisit_ms"}))),
       m_workers(readKey<int>(json, {"workers"})),
+      m_housekeepingCores(readCores(json, "threads", "housekeeping_cores")),
+      m_isMemoryLocked(readKey<bool>(json, {"threads", "lock_memory"})),
+      m_metricsAddress(readKey<std::string>(json, {"metrics", "address"})),
+      m_metricsPort(readKey<int>(json, {"metrics", "port"})),
       m_mqttUrl(getEnv("MQTT_URL")),
       m_mqttUsername(getEnv("MQTT_USER")),
       m_mqttPassword(getEnv("MQTT_PASSWORD")) {}
@@ -107,6 +179,12 @@ Config Config::loadFromFile(const std::string& path) {
   }
 }
 
+Config Config::loadFromJson(nlohmann::json json) {
+  ConfigMigrator::update(json);
+  ConfigMigrator::sort(json);
+  return Config(json);
+}
+
 void Config::saveToFile(const std::string& path, const nlohmann::json& json) {
   FILE* file = fopen(path.c_str(), "w");
   if (file) {
@@ -122,16 +200,50 @@ void Config::saveToFile(const std::string& path, const nlohmann::json& json) {
   }
 }
 
+bool Config::isRestartRequired(const Config& previous, const Config& next) {
+  // devices, ignored ranges and workers are applied to running devices
+  const auto getGlobal = [](nlohmann::json json) {
+    for (const auto key : {"devices", "ignored_frequencies", "workers"}) {
+      json.erase(key);
+    }
+    return json;
+  };
+  return getGlobal(previous.m_json) != getGlobal(next.m_json);
+}
+
+bool Config::isRebuildRequired(const Device& previous, const Device& next) {
+  const auto getHardware = [](const Device& device) {
+    return std::tie(
+        device.m_enabled,
+        device.m_gains,
+        device.m_serial,
+        device.m_driver,
+        device.m_sampleRate,
+        device.m_replayFile,
+        device.m_replayRealTime,
+        device.m_replayLoop,
+        device.m_sourceCores,
+        device.m_detectionCores,
+        device.m_sourcePriority,
+        device.m_sampleFormat);
+  };
+  return getHardware(previous) != getHardware(next);
+}
+
 nlohmann::json Config::json() const { return m_json; }
 std::string Config::mqtt() const { return fmt::format("{}@{}", m_mqttUsername, m_mqttUrl); };
 
-std::vector<Device> Config::devices() const { return m_devices; }
+const std::vector<Device>& Config::devices() const { return m_devices; }
+ScanSettings Config::scanSettings(const Device& device) const { return {device.m_startLevel, device.m_stopLevel, recordersCount(), device.m_ranges, m_ignoredRanges}; }
 
 bool Config::isColorLogEnabled() const { return m_isColorLogEnabled; }
 spdlog::level::level_enum Config::consoleLogLevel() const { return m_consoleLogLevel; }
 spdlog::level::level_enum Config::fileLogLevel() const { return m_fileLogLevel; }
+LogMode Config::logMode() const { return m_logMode; }
+int Config::logQueueSize() const { return m_logQueueSize; }
 
-std::vector<FrequencyRange> Config::ignoredRanges() const { return m_ignoredRanges; }
+int Config::detectionFps() const { return m_detectionFps; }
+const std::vector<FrequencyRange>& Config::ignoredRanges() const { return m_ignoredRanges; }
 int Config::recordersCount() const {
   const auto max_workers = static_cast<int>(std::thread::hardware_concurrency() / 2);
   const auto workers = std::max(0, std::min(m_workers, max_workers));
@@ -140,7 +252,17 @@ int Config::recordersCount() const {
 Frequency Config::recordingBandwidth() const { return m_recordingBandwidth; }
 std::chrono::milliseconds Config::recordingMinTime() const { return m_recordingMinTime; }
 std::chrono::milliseconds Config::recordingTimeout() const { return m_recordingTimeout; }
+std::chrono::milliseconds Config::recordingPreTrigger() const { return m_recordingPreTrigger; }
 Frequency Config::recordingTuningStep() const { return m_recordingTuningStep; }
+std::chrono::milliseconds Config::scanningMinDwell() const { return m_scanningMinDwell; }
+std::chrono::milliseconds Config::scanningMaxDwell() const { return m_scanningMaxDwell; }
+std::chrono::milliseconds Config::scanningMinRevisit() const { return m_scanningMinRevisit; }
+std::chrono::milliseconds Config::scanningMaxRevisit() const { return m_scanningMaxRevisit; }
+
+const std::vector<int>& Config::housekeepingCores() const { return m_housekeepingCores; }
+bool Config::isMemoryLocked() const { return m_isMemoryLocked; }
+const std::string& Config::metricsAddress() const { return m_metricsAddress; }
+int Config::metricsPort() const { return m_metricsPort; }
 
 std::string Config::mqttUrl() const { return m_mqttUrl; }
 std::string Config::mqttUsername() const { return m_mqttUsername; }
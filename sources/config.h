@@ -11,51 +11,103 @@
 constexpr auto DEBUG_SAVE_FULL_RAW_IQ = false;                            // save orgignal sdr data as raw iq
 constexpr auto DEBUG_SAVE_FULL_POWER = false;                             // save orgignal sdr data as raw iq
 constexpr auto DEBUG_SAVE_RECORDING_RAW_IQ = false;                       // save recordings as raw iq
+constexpr auto DEFAULT_ASYNC_LOG_QUEUE_SIZE = 8192;                       // async log queue size in messages, preallocated
+constexpr auto DEVICE_CACHE_FILE_NAME = "devices.cache";                  // probed soapy device capabilities, reused while device is unchanged
+constexpr auto FILE_SINK_BUFFER_SIZE = 1024 * 1024;                       // flushable file sink buffer size in items
 constexpr auto INITIAL_DELAY = std::chrono::milliseconds(1000);           // delay after first start sdr device to start processing
 constexpr auto LOG_FILE_NAME = "sdr_scanner.log";                         // log filename
 constexpr auto LOG_FILE_SIZE = 10 * 1024 * 1024;                          // single log file max size
 constexpr auto LOG_FILES_COUNT = 9;                                       // keep last n log files
+constexpr auto METRICS_POLL_INTERVAL = std::chrono::milliseconds(500);    // metrics server checks stop request every n
+constexpr auto METRICS_CLIENT_TIMEOUT = std::chrono::milliseconds(1000);  // drop metrics client if request or response stalls for
+constexpr auto DEFAULT_METRICS_ADDRESS = "127.0.0.1";                     // metrics server listens only on loopback unless configured
+constexpr auto PAYLOAD_POOL_SIZE = 64;                                    // keep n released mqtt payload buffers for reuse
 constexpr auto PERFORMANCE_LOGGER_INTERVAL = 1000;                        // print stats every n frames
+constexpr auto RECORDER_BUFFER_SIZE = 32;                                 // recorder buffer size in flush intervals, oldest data is overwritten
 constexpr auto RECORDER_FLUSH_INTERVAL = std::chrono::milliseconds(100);  // flush recordings to mqtt every 2 * n bytes
 constexpr auto RESAMPLER_THRESHOLD = 125;                                 // max interpolation or decimation factor of RESAMPLER
+constexpr auto RETUNE_SETTLE_TIME = std::chrono::milliseconds(20);        // drop samples after retune while tuner settles
+constexpr auto SCANNER_WAIT_TIMEOUT = std::chrono::milliseconds(1000);    // leave range if detection frames not received in
 constexpr auto TRANSMISSION_MAX_TIME = std::chrono::minutes(10);          // break transmission if longer that
 
 // SCANNING SETTINGS
-constexpr auto NOISE_LEARNING_TIME = std::chrono::milliseconds(2000);  // noise learnig time
-constexpr auto RANGE_SCANNING_TIME = std::chrono::milliseconds(500);   // waiting time for transmission in single scanning range
+constexpr auto NOISE_QUANTILE = 0.2f;                                            // tracked noise floor percentile of every bin
+constexpr auto NOISE_QUANTILE_MARGIN = 12.0f;                                    // threshold above noise floor, close to max hold of noise
+constexpr auto NOISE_TRACKING_WARMUP = 8;                                        // noise floor updates before detection starts on new frequency
+constexpr auto NOISE_TRACKING_DECIMATION = 4;                                    // update noise floor every n-th frame after warmup
+constexpr auto NOISE_TRACKING_INITIAL_STEP = 3.0f;                               // first noise floor update step in dB, decays with 1 / sqrt(updates)
+constexpr auto NOISE_TRACKING_STEP = 0.05f;                                      // min noise floor update step in dB, limits drift tracking speed
+constexpr auto NOISE_CACHE_MIN_UPDATES = 100;                                    // store noise floor in cache after n updates
+constexpr auto NOISE_CACHE_STORE_INTERVAL = std::chrono::minutes(10);            // store noise floor in cache not more often than
+constexpr auto NOISE_CACHE_MAX_AGE = std::chrono::hours(24);                     // relearn cached noise if older than
+constexpr auto DEFAULT_SCANNING_MIN_DWELL = std::chrono::milliseconds(500);      // waiting time for transmission in quiet range
+constexpr auto DEFAULT_SCANNING_MAX_DWELL = std::chrono::milliseconds(2000);     // waiting time for transmission in busy range
+constexpr auto DEFAULT_SCANNING_MIN_REVISIT = std::chrono::milliseconds(1000);   // do not revisit range earlier if other ranges are waiting
+constexpr auto DEFAULT_SCANNING_MAX_REVISIT = std::chrono::milliseconds(10000);  // revisit every range at least that often
+constexpr auto SCANNING_ACTIVITY_DECAY = std::chrono::seconds(60);               // last detection impact on range activity half life
+constexpr auto SCANNING_OCCUPANCY_SMOOTHING = 0.3;                               // weight of last visit in range occupancy
+constexpr auto SCANNING_BUSY_WEIGHT = 10.0;                                      // revisit busy range n times more often than quiet one
 
 // SIGNAL DETECTION SETTINGS
-constexpr auto GROUPING_X = 21;                    // average n frames in frequency domain
-constexpr auto GROUPING_Y = 21;                    // average n frames in time domain
-constexpr auto DEFAULT_RECORDING_START_LEVEL = 8;  // start recording if average power greather than n
-constexpr auto DEFAULT_RECORDING_STOP_LEVEL = 5;   // stop recording if average power lower than n
-constexpr auto SIGNAL_DETECTION_FPS = 50;          // reduce cpu usage
-constexpr auto SIGNAL_DETECTION_MAX_STEP = 250;    // max step after fft
+constexpr auto GROUPING_X = 21;                                                 // average n frames in frequency domain
+constexpr auto GROUPING_Y = 21;                                                 // average n frames in time domain
+constexpr auto DEFAULT_RECORDING_START_LEVEL = 8;                               // start recording if average power greather than n
+constexpr auto DEFAULT_RECORDING_STOP_LEVEL = 5;                                // stop recording if average power lower than n
+constexpr auto DEFAULT_RECORDING_PRE_TRIGGER = std::chrono::milliseconds(500);  // record n before transmission was detected
+constexpr auto DEFAULT_DETECTION_FPS = 50;                                      // reduce cpu usage
+constexpr auto SIGNAL_DETECTION_MAX_STEP = 250;                                 // max step after fft
 
 // SPECTROGRAM SETTINGS
 constexpr auto SPECTROGRAM_PREFERRED_MAX_STEP = 1000;                        // spectrogram preferred max step
 constexpr auto SPECTROGRAM_MAX_FFT = 16384;                                  // spectrogram fft limit
 constexpr auto SPECTROGRAM_SEND_INTERVAL = std::chrono::milliseconds(1000);  // send spectrogram data interval
 
+// LIVE SPECTROGRAM SETTINGS
+constexpr auto LIVE_SPECTROGRAM_DEFAULT_FPS = 10;                                     // live rows per second if not requested
+constexpr auto LIVE_SPECTROGRAM_MAX_FPS = 25;                                         // live rows per second limit
+constexpr auto LIVE_SPECTROGRAM_DEFAULT_BINS = 1024;                                  // live row size if not requested
+constexpr auto LIVE_SPECTROGRAM_MIN_BINS = 64;                                        // live row size lower limit
+constexpr auto LIVE_SPECTROGRAM_MAX_BINS = 16384;                                     // live row size upper limit
+constexpr auto LIVE_SPECTROGRAM_KEYFRAME_INTERVAL = std::chrono::milliseconds(2000);  // send full row at least every n
+constexpr auto LIVE_SPECTROGRAM_TIMEOUT = std::chrono::seconds(30);                   // stop streaming if request not renewed
+constexpr auto LIVE_SPECTROGRAM_MAX_CLIENTS = 32;                                     // ignore live requests from more clients
+
 class Config {
  public:
   static Config loadFromFile(const std::string& path);
+  static Config loadFromJson(nlohmann::json json);
   static void saveToFile(const std::string& path, const nlohmann::json& json);
+  static bool isRestartRequired(const Config& previous, const Config& next);
+  static bool isRebuildRequired(const Device& previous, const Device& next);
   nlohmann::json json() const;
   std::string mqtt() const;
 
-  std::vector<Device> devices() const;
+  const std::vector<Device>& devices() const;
+  ScanSettings scanSettings(const Device& device) const;
 
   bool isColorLogEnabled() const;
   spdlog::level::level_enum consoleLogLevel() const;
   spdlog::level::level_enum fileLogLevel() const;
+  LogMode logMode() const;
+  int logQueueSize() const;
 
-  std::vector<FrequencyRange> ignoredRanges() const;
+  int detectionFps() const;
+  const std::vector<FrequencyRange>& ignoredRanges() const;
   int recordersCount() const;
   Frequency recordingBandwidth() const;
   std::chrono::milliseconds recordingMinTime() const;
   std::chrono::milliseconds recordingTimeout() const;
+  std::chrono::milliseconds recordingPreTrigger() const;
   Frequency recordingTuningStep() const;
+  std::chrono::milliseconds scanningMinDwell() const;
+  std::chrono::milliseconds scanningMaxDwell() const;
+  std::chrono::milliseconds scanningMinRevisit() const;
+  std::chrono::milliseconds scanningMaxRevisit() const;
+
+  const std::vector<int>& housekeepingCores() const;
+  bool isMemoryLocked() const;
+  const std::string& metricsAddress() const;
+  int metricsPort() const;
 
   std::string mqttUrl() const;
   std::string mqttUsername() const;
@@ -71,13 +123,25 @@ class Config {
   const bool m_isColorLogEnabled;
   const spdlog::level::level_enum m_consoleLogLevel;
   const spdlog::level::level_enum m_fileLogLevel;
+  const LogMode m_logMode;
+  const int m_logQueueSize;
 
+  const int m_detectionFps;
   const std::vector<FrequencyRange> m_ignoredRanges;
   const Frequency m_recordingBandwidth;
   const std::chrono::milliseconds m_recordingMinTime;
   const std::chrono::milliseconds m_recordingTimeout;
+  const std::chrono::milliseconds m_recordingPreTrigger;
   const Frequency m_recordingTuningStep;
+  const std::chrono::milliseconds m_scanningMinDwell;
+  const std::chrono::milliseconds m_scanningMaxDwell;
+  const std::chrono::milliseconds m_scanningMinRevisit;
+  const std::chrono::milliseconds m_scanningMaxRevisit;
   const int m_workers;
+  const std::vector<int> m_housekeepingCores;
+  const bool m_isMemoryLocked;
+  const std::string m_metricsAddress;
+  const int m_metricsPort;
 
   const std::string m_mqttUrl;
   const std::string m_mqttUsername;
@@ -1,5 +1,6 @@
 #include "config_migrator.h"
 
+#include <config.h>
 #include <logger.h>
 #include <radio/help_structures.h>
 
@@ -10,6 +11,13 @@ void ConfigMigrator::update(nlohmann::json& config) {
   Logger::info(LABEL, "version: {}", colored(GREEN, "{}", version));
 
   if (version < 2) applyVersion2(config);
+  if (version < 3) applyVersion3(config);
+  if (version < 4) applyVersion4(config);
+  if (version < 5) applyVersion5(config);
+  if (version < 6) applyVersion6(config);
+  if (version < 7) applyVersion7(config);
+  if (version < 8) applyVersion8(config);
+  if (version < 9) applyVersion9(config);
 }
 
 void ConfigMigrator::sort(nlohmann::json& json) {
@@ -26,6 +34,9 @@ void ConfigMigrator::sort(nlohmann::json& json) {
 
   auto& devices = json.at("devices");
   for (auto& device : devices) {
+    if (!device.contains("ranges")) {
+      continue;
+    }
     auto& ranges = device.at("ranges");
     std::sort(ranges.begin(), ranges.end(), [](const nlohmann::json& r1, const nlohmann::json& r2) { return r1.at("start").get<Frequency>() < r2.at("start").get<Frequency>(); });
   }
@@ -36,4 +47,60 @@ void ConfigMigrator::applyVersion(nlohmann::json& config, const int version) {
   config["version"] = version;
 }
 
-void ConfigMigrator::applyVersion2(nlohmann::json& config) { std::ignore = config; }
+void ConfigMigrator::applyVersion2(nlohmann::json& config) {
+  config["detection"] = {{"fps", DEFAULT_DETECTION_FPS}};
+  applyVersion(config, 2);
+}
+
+void ConfigMigrator::applyVersion3(nlohmann::json& config) {
+  config["scanning"] = {
+      {"min_dwell_ms", DEFAULT_SCANNING_MIN_DWELL.count()},
+      {"max_dwell_ms", DEFAULT_SCANNING_MAX_DWELL.count()},
+      {"min_revisit_ms", DEFAULT_SCANNING_MIN_REVISIT.count()},
+      {"max_revisit_ms", DEFAULT_SCANNING_MAX_REVISIT.count()},
+  };
+  applyVersion(config, 3);
+}
+
+void ConfigMigrator::applyVersion4(nlohmann::json& config) {
+  config["threads"] = {
+      {"housekeeping_cores", nlohmann::json::array()},
+      {"lock_memory", false},
+  };
+  for (auto& device : config.at("devices")) {
+    device["source_cores"] = nlohmann::json::array();
+    device["detection_cores"] = nlohmann::json::array();
+    device["source_priority"] = 0;
+  }
+  applyVersion(config, 4);
+}
+
+void ConfigMigrator::applyVersion5(nlohmann::json& config) {
+  config["metrics"] = {{"port", 0}};
+  applyVersion(config, 5);
+}
+
+void ConfigMigrator::applyVersion6(nlohmann::json& config) {
+  for (auto& device : config.at("devices")) {
+    if (!device.contains("replay")) {
+      device["sample_format"] = "cf32";
+    }
+  }
+  applyVersion(config, 6);
+}
+
+void ConfigMigrator::applyVersion7(nlohmann::json& config) {
+  config["recording"]["pre_trigger_ms"] = DEFAULT_RECORDING_PRE_TRIGGER.count();
+  applyVersion(config, 7);
+}
+
+void ConfigMigrator::applyVersion8(nlohmann::json& config) {
+  config["output"]["async_log_mode"] = "off";
+  config["output"]["async_log_queue_size"] = DEFAULT_ASYNC_LOG_QUEUE_SIZE;
+  applyVersion(config, 8);
+}
+
+void ConfigMigrator::applyVersion9(nlohmann::json& config) {
+  config["metrics"]["address"] = DEFAULT_METRICS_ADDRESS;
+  applyVersion(config, 9);
+}
@@ -13,4 +13,11 @@ class ConfigMigrator {
 
   static void applyVersion(nlohmann::json& config, const int version);
   static void applyVersion2(nlohmann::json& config);
+  static void applyVersion3(nlohmann::json& config);
+  static void applyVersion4(nlohmann::json& config);
+  static void applyVersion5(nlohmann::json& config);
+  static void applyVersion6(nlohmann::json& config);
+  static void applyVersion7(nlohmann::json& config);
+  static void applyVersion8(nlohmann::json& config);
+  static void applyVersion9(nlohmann::json& config);
 };
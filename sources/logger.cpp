@@ -1,27 +1,51 @@
 #include "logger.h"
 
+#include <spdlog/async.h>
 #include <spdlog/sinks/basic_file_sink.h>
 #include <spdlog/sinks/daily_file_sink.h>
 #include <spdlog/sinks/rotating_file_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
+#include <utils/thread_utils.h>
 
 void Logger::Logger::configure(
-    const spdlog::level::level_enum logLevelConsole, const spdlog::level::level_enum logLevelFile, const std::string& logFile, int fileSize, int filesCount, bool isColorLogEnabled) {
+    const spdlog::level::level_enum logLevelConsole,
+    const spdlog::level::level_enum logLevelFile,
+    const std::string& logFile,
+    int fileSize,
+    int filesCount,
+    bool isColorLogEnabled,
+    const LogMode mode,
+    const int queueSize,
+    const std::vector<int>& cores) {
   spdlog::drop_all();
   _logger.reset();
+  if (_threadPool) {
+    _dropped = dropped();
+    // waits until queued messages are written
+    _threadPool.reset();
+  }
 
   auto consoleLogger = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
   consoleLogger->set_level(logLevelConsole);
 
+  std::vector<spdlog::sink_ptr> sinks;
+
   if (logLevelFile == spdlog::level::off || logFile.empty()) {
-    std::initializer_list<spdlog::sink_ptr> loggers{consoleLogger};
-    Logger::_logger = std::make_shared<spdlog::logger>("auto_sdr", loggers);
+    sinks.push_back(consoleLogger);
   } else {
     auto fileLogger = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(logFile, fileSize, filesCount);
     fileLogger->set_level(logLevelFile);
+    sinks.push_back(consoleLogger);
+    sinks.push_back(fileLogger);
+  }
 
-    std::initializer_list<spdlog::sink_ptr> loggers{consoleLogger, fileLogger};
-    Logger::_logger = std::make_shared<spdlog::logger>("auto_sdr", loggers);
+  if (mode == LogMode::Sync) {
+    Logger::_logger = std::make_shared<spdlog::logger>("auto_sdr", sinks.begin(), sinks.end());
+  } else {
+    // queue is preallocated, single thread keeps messages ordered
+    _threadPool = std::make_shared<spdlog::details::thread_pool>(queueSize, 1, [cores]() { setThreadAffinity(pthread_self(), cores); });
+    const auto policy = mode == LogMode::AsyncBlock ? spdlog::async_overflow_policy::block : spdlog::async_overflow_policy::overrun_oldest;
+    Logger::_logger = std::make_shared<spdlog::async_logger>("auto_sdr", sinks.begin(), sinks.end(), _threadPool, policy);
   }
 
   _logger->set_level(std::min(logLevelConsole, logLevelFile));
@@ -30,3 +54,5 @@ void Logger::Logger::configure(
   spdlog::flush_every(std::chrono::seconds(10));
   _isColorLogEnabled = isColorLogEnabled;
 }
+
+uint64_t Logger::dropped() { return _dropped + (_threadPool ? _threadPool->overrun_counter() : 0); }
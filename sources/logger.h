@@ -3,6 +3,27 @@
 #define FMT_HEADER_ONLY
 #include <spdlog/spdlog.h>
 
+#include <iterator>
+#include <vector>
+
+// lowest level compiled in, SPDLOG_LEVEL_INFO drops trace and debug logs completely
+#ifndef LOGGER_ACTIVE_LEVEL
+#define LOGGER_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+// format is checked at compile time, trailing {} consumes empty argument so macros work without arguments
+#define LOGGER_FORMAT(format, ...) FMT_STRING("[{:12}] " format "{}")
+#define LOGGER_ARGS(format, ...) __VA_ARGS__
+#define LOGGER_LOG(isCompiled, level, label, ...)                                              \
+  do {                                                                                         \
+    if (isCompiled && Logger::isEnabled(level)) {                                              \
+      Logger::log(level, LOGGER_FORMAT(__VA_ARGS__, ""), label, LOGGER_ARGS(__VA_ARGS__, "")); \
+    }                                                                                          \
+  } while (0)
+
+#define LOG_TRACE(label, ...) LOGGER_LOG(LOGGER_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE, spdlog::level::trace, label, __VA_ARGS__)
+#define LOG_DEBUG(label, ...) LOGGER_LOG(LOGGER_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG, spdlog::level::debug, label, __VA_ARGS__)
+
 constexpr auto LOGGER_BUFFER_SIZE = 1024;
 constexpr auto RED = "\033[0;31m";
 constexpr auto GREEN = "\033[0;32m";
@@ -13,28 +34,35 @@ constexpr auto YELLOW = "\033[0;93m";
 constexpr auto BLUE = "\033[0;94m";
 constexpr auto NC = "\033[0m";
 
+namespace spdlog::details {
+class thread_pool;
+}
+
+// async modes write logs from dedicated thread, full queue either blocks caller or drops oldest message
+enum class LogMode { Sync, AsyncBlock, AsyncDropOldest };
+
 class Logger {
  public:
   static void configure(
-      const spdlog::level::level_enum logLevelConsole, const spdlog::level::level_enum logLevelFile, const std::string& logFile, int fileSize, int filesCount, bool isColorLogEnabled);
+      const spdlog::level::level_enum logLevelConsole,
+      const spdlog::level::level_enum logLevelFile,
+      const std::string& logFile,
+      int fileSize,
+      int filesCount,
+      bool isColorLogEnabled,
+      const LogMode mode,
+      const int queueSize,
+      const std::vector<int>& cores);
 
+  // use LOG_TRACE and LOG_DEBUG macros, arguments are evaluated only if level is enabled
   template <typename... Args>
-  static void trace(const char* label, const char* fmt, const Args&... args) {
-    char buf[LOGGER_BUFFER_SIZE];
-    buf[0] = 0;
-    strcat(buf, "[{:12}] ");
-    strcat(buf, fmt);
-    Logger::_logger->trace(buf, label, args...);
+  static void log(const spdlog::level::level_enum level, fmt::format_string<const char*, Args...> format, const char* label, Args&&... args) {
+    fmt::memory_buffer buf;
+    fmt::format_to(std::back_inserter(buf), format, label, std::forward<Args>(args)...);
+    Logger::_logger->log(level, spdlog::string_view_t(buf.data(), buf.size()));
   }
 
-  template <typename... Args>
-  static void debug(const char* label, const char* fmt, const Args&... args) {
-    char buf[LOGGER_BUFFER_SIZE];
-    buf[0] = 0;
-    strcat(buf, "[{:12}] ");
-    strcat(buf, fmt);
-    Logger::_logger->debug(buf, label, args...);
-  }
+  static bool isEnabled(const spdlog::level::level_enum level) { return Logger::_logger && Logger::_logger->should_log(level); }
 
   template <typename... Args>
   static void info(const char* label, const char* fmt, const Args&... args) {
@@ -73,6 +101,7 @@ class Logger {
   }
 
   static void flush() { Logger::_logger->flush(); }
+  static uint64_t dropped();
   static bool isColorLogEnabled() { return _isColorLogEnabled; }
 
  private:
@@ -80,6 +109,8 @@ class Logger {
   ~Logger() = delete;
 
   inline static std::shared_ptr<spdlog::logger> _logger = nullptr;
+  inline static std::shared_ptr<spdlog::details::thread_pool> _threadPool = nullptr;
+  inline static uint64_t _dropped = 0;
   inline static bool _isColorLogEnabled = true;
 };
 
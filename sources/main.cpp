@@ -1,11 +1,16 @@
 #include <SoapySDR/Logger.h>
 #include <config.h>
 #include <logger.h>
+#include <metrics.h>
+#include <network/metrics_server.h>
 #include <network/mqtt.h>
 #include <network/remote_controller.h>
-#include <scanner.h>
+#include <scanner_pool.h>
 #include <signal.h>
+#include <utils/snapshot.h>
+#include <utils/thread_utils.h>
 
+#include <atomic>
 #include <memory>
 #include <thread>
 
@@ -25,7 +30,7 @@ int main(int argc, char** argv) {
   signal(SIGTERM, handler);
 
   try {
-    Logger::configure(spdlog::level::info, spdlog::level::info, LOG_FILE_NAME, LOG_FILE_SIZE, LOG_FILES_COUNT, true);
+    Logger::configure(spdlog::level::info, spdlog::level::info, LOG_FILE_NAME, LOG_FILE_SIZE, LOG_FILES_COUNT, true, LogMode::Sync, 0, {});
     Logger::info(LABEL, "{}", colored(GREEN, "{}", "starting"));
     const std::string configFile = 2 <= argc ? argv[1] : "";
     if (configFile.empty()) {
@@ -34,40 +39,72 @@ int main(int argc, char** argv) {
     }
 
     const auto id = generateRandomHash();
+    uint64_t reportedLogDropped = 0;
     while (isRunning) {
-      bool reload = false;
-      const Config config = Config::loadFromFile(configFile);
-      Logger::configure(config.consoleLogLevel(), config.fileLogLevel(), LOG_FILE_NAME, LOG_FILE_SIZE, LOG_FILES_COUNT, config.isColorLogEnabled());
+      std::atomic<bool> reload{false};
+      bool restart = false;
+      const auto initialConfig = std::make_shared<const Config>(Config::loadFromFile(configFile));
+      const auto& config = *initialConfig;
+      Logger::configure(
+          config.consoleLogLevel(),
+          config.fileLogLevel(),
+          LOG_FILE_NAME,
+          LOG_FILE_SIZE,
+          LOG_FILES_COUNT,
+          config.isColorLogEnabled(),
+          config.logMode(),
+          config.logQueueSize(),
+          config.housekeepingCores());
       Logger::info(LABEL, "config: {}", colored(GREEN, "{}", config.json().dump()));
       Logger::info(LABEL, "mqtt: {}", colored(GREEN, "{}", config.mqtt()));
+      if (config.isMemoryLocked()) {
+        if (lockMemory()) {
+          Logger::info(LABEL, "memory locked");
+        } else {
+          Logger::warn(LABEL, "lock memory failed, errno: {}", errno);
+        }
+      }
+      Logger::info(LABEL, "housekeeping cores: {}", colored(GREEN, "{}", formatCores(config.housekeepingCores())));
 
+      std::unique_ptr<MetricsServer> metricsServer;
+      if (0 < config.metricsPort()) {
+        try {
+          metricsServer = std::make_unique<MetricsServer>(config.metricsAddress(), config.metricsPort(), config.housekeepingCores());
+        } catch (const std::exception& exception) {
+          Logger::warn(LABEL, "can not start metrics server: {}", exception.what());
+        }
+      }
       Mqtt mqtt(config);
-      RemoteController remoteController(config, id, mqtt, [&reload, &configFile](const nlohmann::json& json) {
+      Snapshot<Config> currentConfig(initialConfig);
+      RemoteController remoteController(currentConfig, id, mqtt, [&reload, &configFile](const nlohmann::json& json) {
         Logger::info(LABEL, "reload config: {}", colored(GREEN, "{}", json.dump()));
         Config::saveToFile(configFile, json);
         reload = true;
       });
-      std::vector<std::unique_ptr<Scanner>> scanners;
-      for (const auto& device : config.devices()) {
-        try {
-          if (!device.m_enabled) {
-            Logger::info(LABEL, "device disabled, skipping: {}", colored(GREEN, "{}", device.getName()));
-          } else if (device.m_ranges.empty()) {
-            Logger::info(LABEL, "empty ranges to scan, skipping: {}", colored(GREEN, "{}", device.getName()));
-          } else {
-            scanners.push_back(std::make_unique<Scanner>(config, device, mqtt, config.recordersCount()));
-          }
-        } catch (const std::exception& exception) {
-          Logger::error(LABEL, "can not open device: {}, exception: {}", colored(RED, "{}", device.getName()), exception.what());
-        }
-      }
-      if (scanners.empty()) {
-        Logger::warn(LABEL, "{}", colored(RED, "{}", "empty devices list"));
-      }
+      ScannerPool scanners(mqtt);
+      scanners.update(initialConfig);
 
       Logger::info(LABEL, "{}", colored(GREEN, "{}", "started"));
-      while (isRunning && !reload) {
+      while (isRunning && !restart) {
         std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        const auto logDropped = Logger::dropped();
+        Metrics::increment("log_dropped_total", logDropped - reportedLogDropped);
+        reportedLogDropped = logDropped;
+        if (reload.exchange(false)) {
+          try {
+            const auto newConfig = std::make_shared<const Config>(Config::loadFromFile(configFile));
+            if (Config::isRestartRequired(*currentConfig.load(), *newConfig)) {
+              Logger::info(LABEL, "global settings changed, restarting");
+              restart = true;
+            } else {
+              scanners.update(newConfig);
+              currentConfig.store(newConfig);
+              Logger::info(LABEL, "{}", colored(GREEN, "{}", "config applied"));
+            }
+          } catch (const std::exception& exception) {
+            Logger::warn(LABEL, "reload config failed, keeping current config: {}", exception.what());
+          }
+        }
       }
     }
     Logger::info(LABEL, "{}", colored(GREEN, "{}", "stopped"));
@@ -0,0 +1,86 @@
+#include "metrics.h"
+
+#include <logger.h>
+
+#include <algorithm>
+
+namespace {
+// suffix goes before labels: name{labels} -> name_suffix{labels}
+std::string withSuffix(const std::string& name, const char* suffix) {
+  const auto position = std::min(name.find('{'), name.size());
+  return name.substr(0, position) + suffix + name.substr(position);
+}
+
+bool hasLabel(const std::string& name, const std::string& label) {
+  for (auto position = name.find(label); position != std::string::npos; position = name.find(label, position + 1)) {
+    const auto end = position + label.size();
+    if (0 < position && (name[position - 1] == '{' || name[position - 1] == ',') && end < name.size() && (name[end] == '}' || name[end] == ',')) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+void Metrics::increment(const std::string& name, const uint64_t value) {
+  std::unique_lock lock(_mutex);
+  _counters[name] += value;
+}
+
+void Metrics::set(const std::string& name, const double value) {
+  std::unique_lock lock(_mutex);
+  _gauges[name] = value;
+}
+
+void Metrics::observe(const std::string& name, const double value) {
+  std::unique_lock lock(_mutex);
+  auto it = _summaries.find(name);
+  if (it == _summaries.end()) {
+    _summaries[name] = {1, value, value};
+  } else {
+    it->second.m_count++;
+    it->second.m_sum += value;
+    it->second.m_max = std::max(it->second.m_max, value);
+  }
+}
+
+void Metrics::removeGauges(const std::string& label) {
+  std::unique_lock lock(_mutex);
+  for (auto it = _gauges.begin(); it != _gauges.end();) {
+    it = hasLabel(it->first, label) ? _gauges.erase(it) : std::next(it);
+  }
+}
+
+std::string Metrics::format() {
+  std::unique_lock lock(_mutex);
+  // samples of one metric family are grouped under its type line
+  std::map<std::string, std::pair<const char*, std::string>> families;
+  const auto add = [&families](const std::string& name, const char* type, const auto value) {
+    auto& family = families[name.substr(0, name.find('{'))];
+    family.first = type;
+    family.second += fmt::format("{} {}\n", name, value);
+  };
+  for (const auto& [name, value] : _counters) {
+    add(name, "counter", value);
+  }
+  for (const auto& [name, value] : _gauges) {
+    add(name, "gauge", value);
+  }
+  for (const auto& [name, summary] : _summaries) {
+    add(withSuffix(name, "_count"), "counter", summary.m_count);
+    add(withSuffix(name, "_sum"), "counter", summary.m_sum);
+    add(withSuffix(name, "_max"), "gauge", summary.m_max);
+  }
+  std::string data;
+  for (const auto& [family, samples] : families) {
+    data += fmt::format("# TYPE {} {}\n{}", family, samples.first, samples.second);
+  }
+  return data;
+}
+
+void Metrics::clear() {
+  std::unique_lock lock(_mutex);
+  _counters.clear();
+  _gauges.clear();
+  _summaries.clear();
+}
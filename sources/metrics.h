@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+// process wide metrics, name may contain prometheus labels, e.g. retune_latency_ms{device="rtlsdr_0001"}
+// summary is exported as counters name_count, name_sum and gauge name_max
+class Metrics {
+  struct Summary {
+    uint64_t m_count;
+    double m_sum;
+    double m_max;
+  };
+
+ public:
+  static void increment(const std::string& name, const uint64_t value = 1);
+  static void set(const std::string& name, const double value);
+  static void observe(const std::string& name, const double value);
+  static void removeGauges(const std::string& label);
+  static std::string format();
+  static void clear();
+
+ private:
+  Metrics() = delete;
+  ~Metrics() = delete;
+
+  inline static std::mutex _mutex;
+  inline static std::map<std::string, uint64_t> _counters;
+  inline static std::map<std::string, double> _gauges;
+  inline static std::map<std::string, Summary> _summaries;
+};
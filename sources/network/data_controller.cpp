@@ -1,9 +1,14 @@
 #include "data_controller.h"
 
 #include <string.h>
+#include <utils/simd_utils.h>
+#include <utils/utils.h>
 
 #include <cstdlib>
 #include <memory>
+#include <nlohmann/json.hpp>
+
+constexpr auto LABEL = "data";
 
 template <typename T>
 void add(uint8_t* p, uint64_t& offset, const T& value) {
@@ -20,38 +25,123 @@ void add(uint8_t* p, uint64_t& offset, const T* value, int size) {
 }
 
 DataController::DataController(Mqtt& mqtt, const std::string& deviceName)
-    : m_mqtt(mqtt), m_spectrogramTopic(fmt::format("sdr/{}/spectrogram", deviceName)), m_transmissionsTopic(fmt::format("sdr/{}/transmission/uint8", deviceName)) {}
+    : m_mqtt(mqtt),
+      m_spectrogramTopic(fmt::format("sdr/{}/spectrogram", deviceName)),
+      m_liveSpectrogramTopic(fmt::format("sdr/{}/live/spectrogram", deviceName)),
+      m_transmissionsTopic(fmt::format("sdr/{}/transmission/uint8", deviceName)),
+      m_spectrogramMetric(Mqtt::getPublishedMetric(m_spectrogramTopic)),
+      m_liveSpectrogramMetric(Mqtt::getPublishedMetric(m_liveSpectrogramTopic)),
+      m_transmissionsMetric(Mqtt::getPublishedMetric(m_transmissionsTopic)),
+      m_payloadPool(PAYLOAD_POOL_SIZE),
+      m_liveState(std::make_shared<LiveState>()) {
+  // callback copied by mqtt may still run after removal, it keeps its own reference to state
+  const auto state = m_liveState;
+  m_liveRequestCallbackId = m_mqtt.setMessageCallback(fmt::format("sdr/{}/live/request", deviceName), [state](const std::string& data) { liveRequestCallback(*state, data); });
+}
 
-DataController::~DataController() = default;
+DataController::~DataController() { m_mqtt.removeMessageCallback(m_liveRequestCallbackId); }
 
 void DataController::pushTransmission(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const TransmissionData* data, int size) {
+  auto payload = m_payloadPool.get(getTransmissionPayloadSize(size));
+  setTransmissionPayload(reinterpret_cast<uint8_t*>(payload->data()), time, frequency, sampleRate, data, size);
+  m_mqtt.publish(m_transmissionsTopic, std::move(payload), 0, m_transmissionsMetric);
+}
+
+void DataController::pushSpectrogram(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const SpectrogramData* data, int size) {
+  m_mqtt.publish(m_spectrogramTopic, getSpectrogramPayload(time, frequency, sampleRate, data, size), 0, m_spectrogramMetric);
+}
+
+void DataController::pushLiveSpectrogram(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const std::string& data, int size) {
+  m_mqtt.publish(m_liveSpectrogramTopic, getLiveSpectrogramPayload(time, frequency, sampleRate, data, size), 0, m_liveSpectrogramMetric);
+}
+
+std::optional<DataController::LiveRequest> DataController::getLiveRequest(const std::chrono::milliseconds now) const {
+  std::unique_lock lock(m_liveState->m_mutex);
+  std::optional<LiveRequest> request;
+  for (const auto& [id, client] : m_liveState->m_clients) {
+    if (now < client.m_expireTime) {
+      request = request ? LiveRequest{std::max(request->m_fps, client.m_request.m_fps), std::max(request->m_bins, client.m_request.m_bins)} : client.m_request;
+    }
+  }
+  return request;
+}
+
+void DataController::liveRequestCallback(LiveState& state, const std::string& data) {
+  try {
+    const auto json = data.empty() ? nlohmann::json::object() : nlohmann::json::parse(data);
+    const auto fps = json.value("fps", LIVE_SPECTROGRAM_DEFAULT_FPS);
+    const auto bins = json.value("bins", LIVE_SPECTROGRAM_DEFAULT_BINS);
+    const auto id = json.value("id", std::string());
+    if (bins < LIVE_SPECTROGRAM_MIN_BINS || LIVE_SPECTROGRAM_MAX_BINS < bins || (bins & (bins - 1)) != 0) {
+      Logger::warn(LABEL, "invalid live request bins: {}", colored(RED, "{}", bins));
+      return;
+    }
+    const auto now = getTime();
+    std::unique_lock lock(state.m_mutex);
+    for (auto it = state.m_clients.begin(); it != state.m_clients.end();) {
+      it = it->second.m_expireTime <= now ? state.m_clients.erase(it) : std::next(it);
+    }
+    if (fps <= 0) {
+      Logger::info(LABEL, "live request stop, client: {}", colored(GREEN, "{}", id));
+      state.m_clients.erase(id);
+    } else if (state.m_clients.count(id) == 0 && LIVE_SPECTROGRAM_MAX_CLIENTS <= static_cast<int>(state.m_clients.size())) {
+      Logger::warn(LABEL, "live request ignored, too many clients: {}", colored(RED, "{}", state.m_clients.size()));
+    } else {
+      const LiveRequest request{std::min(fps, LIVE_SPECTROGRAM_MAX_FPS), bins};
+      state.m_clients[id] = {request, now + LIVE_SPECTROGRAM_TIMEOUT};
+      LOG_DEBUG(LABEL, "live request, client: {}, fps: {}, bins: {}", colored(GREEN, "{}", id), colored(GREEN, "{}", request.m_fps), colored(GREEN, "{}", request.m_bins));
+    }
+  } catch (const std::exception& e) {
+    Logger::warn(LABEL, "invalid live request: {}", e.what());
+  }
+}
+
+size_t DataController::getTransmissionPayloadSize(int size) { return sizeof(uint64_t) + 2 * sizeof(Frequency) + sizeof(uint32_t) + sizeof(TransmissionData) * size; }
+
+void DataController::setTransmissionPayload(uint8_t* payload, const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const TransmissionData* data, int size) {
   const Frequency start = frequency - sampleRate / 2;
   const Frequency stop = frequency + sampleRate / 2;
-  const auto headerSize = sizeof(uint64_t) + 2 * sizeof(Frequency) + sizeof(uint32_t);
-  std::vector<uint8_t> payload(headerSize + sizeof(TransmissionData) * size);
   uint64_t offset = 0;
-  add(payload.data(), offset, static_cast<uint64_t>(time.count()));
-  add(payload.data(), offset, start);
-  add(payload.data(), offset, stop);
-  add(payload.data(), offset, static_cast<uint32_t>(sampleRate));
-  add(payload.data(), offset, data, size);
-  for (int i = 0; i < size * 2; ++i) {
-    payload[headerSize + i] ^= 0x80;
-  }
-  m_mqtt.publish(m_transmissionsTopic, std::move(payload));
+  add(payload, offset, static_cast<uint64_t>(time.count()));
+  add(payload, offset, start);
+  add(payload, offset, stop);
+  add(payload, offset, static_cast<uint32_t>(sampleRate));
+  // signed samples to unsigned in the same pass as copy
+  copyXor(reinterpret_cast<const uint8_t*>(data), payload + offset, sizeof(TransmissionData) * size, 0x80);
 }
 
-void DataController::pushSpectrogram(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const SpectrogramData* data, int size) {
+std::string DataController::getTransmissionPayload(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const TransmissionData* data, int size) {
+  std::string payload(getTransmissionPayloadSize(size), '\0');
+  setTransmissionPayload(reinterpret_cast<uint8_t*>(payload.data()), time, frequency, sampleRate, data, size);
+  return payload;
+}
+
+std::string DataController::getSpectrogramPayload(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const SpectrogramData* data, int size) {
+  const Frequency start = frequency - sampleRate / 2;
+  const Frequency stop = frequency + sampleRate / 2;
+  const Frequency step = sampleRate / size;
+  std::string payload(sizeof(uint64_t) + 3 * sizeof(Frequency) + sizeof(uint32_t) + sizeof(SpectrogramData) * size, '\0');
+  uint64_t offset = 0;
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, static_cast<uint64_t>(time.count()));
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, start);
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, stop);
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, step);
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, static_cast<uint32_t>(size));
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, data, size);
+  return payload;
+}
+
+std::string DataController::getLiveSpectrogramPayload(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const std::string& data, int size) {
   const Frequency start = frequency - sampleRate / 2;
   const Frequency stop = frequency + sampleRate / 2;
   const Frequency step = sampleRate / size;
-  std::vector<uint8_t> payload(sizeof(uint64_t) + 3 * sizeof(Frequency) + sizeof(uint32_t) + sizeof(SpectrogramData) * size);
+  std::string payload(sizeof(uint64_t) + 3 * sizeof(Frequency) + sizeof(uint32_t) + data.size(), '\0');
   uint64_t offset = 0;
-  add(payload.data(), offset, static_cast<uint64_t>(time.count()));
-  add(payload.data(), offset, start);
-  add(payload.data(), offset, stop);
-  add(payload.data(), offset, step);
-  add(payload.data(), offset, static_cast<uint32_t>(size));
-  add(payload.data(), offset, data, size);
-  m_mqtt.publish(m_spectrogramTopic, std::move(payload));
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, static_cast<uint64_t>(time.count()));
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, start);
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, stop);
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, step);
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, static_cast<uint32_t>(size));
+  add(reinterpret_cast<uint8_t*>(payload.data()), offset, data.data(), data.size());
+  return payload;
 }
@@ -1,9 +1,16 @@
 #pragma once
 
 #include <network/mqtt.h>
+#include <network/payload_pool.h>
 #include <radio/help_structures.h>
 
+#include <chrono>
 #include <complex>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 #include <vector>
 
 class DataController {
@@ -11,14 +18,49 @@ class DataController {
   using TransmissionData = SimpleComplex;
   using SpectrogramData = int8_t;
 
+  struct LiveRequest {
+    int m_fps;
+    int m_bins;
+  };
+
+ private:
+  struct LiveClient {
+    LiveRequest m_request;
+    std::chrono::milliseconds m_expireTime;
+  };
+
+  // one stream is published for all clients, it has highest requested fps and bins
+  struct LiveState {
+    std::mutex m_mutex;
+    std::map<std::string, LiveClient> m_clients;
+  };
+
+ public:
   DataController(Mqtt& mqtt, const std::string& deviceName);
   ~DataController();
 
   void pushTransmission(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const TransmissionData* data, int size);
   void pushSpectrogram(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const SpectrogramData* data, int size);
+  void pushLiveSpectrogram(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const std::string& data, int size);
+  std::optional<LiveRequest> getLiveRequest(const std::chrono::milliseconds now) const;
+
+  static size_t getTransmissionPayloadSize(int size);
+  static void setTransmissionPayload(uint8_t* payload, const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const TransmissionData* data, int size);
+  static std::string getTransmissionPayload(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const TransmissionData* data, int size);
+  static std::string getSpectrogramPayload(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const SpectrogramData* data, int size);
+  static std::string getLiveSpectrogramPayload(const std::chrono::milliseconds time, const Frequency& frequency, const Frequency& sampleRate, const std::string& data, int size);
 
  private:
+  static void liveRequestCallback(LiveState& state, const std::string& data);
+
   Mqtt& m_mqtt;
   const std::string m_spectrogramTopic;
+  const std::string m_liveSpectrogramTopic;
   const std::string m_transmissionsTopic;
+  const std::string m_spectrogramMetric;
+  const std::string m_liveSpectrogramMetric;
+  const std::string m_transmissionsMetric;
+  PayloadPool m_payloadPool;
+  std::shared_ptr<LiveState> m_liveState;
+  int m_liveRequestCallbackId;
 };
@@ -0,0 +1,108 @@
+#include "metrics_server.h"
+
+#include <arpa/inet.h>
+#include <config.h>
+#include <logger.h>
+#include <metrics.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utils/thread_utils.h>
+
+#include <cstring>
+#include <stdexcept>
+
+constexpr auto LABEL = "metrics";
+constexpr auto REQUEST_MAX_SIZE = 4096;
+
+namespace {
+void sendAll(const int client, const std::string& data) {
+  size_t sent = 0;
+  while (sent < data.size()) {
+    const auto result = send(client, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (result <= 0) {
+      return;
+    }
+    sent += result;
+  }
+}
+
+std::string getResponse(const char* status, const std::string& body) {
+  return fmt::format("HTTP/1.1 {}\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: {}\r\nConnection: close\r\n\r\n{}", status, body.size(), body);
+}
+}  // namespace
+
+MetricsServer::MetricsServer(const std::string& address, const int port, const std::vector<int>& cores) : m_socket(socket(AF_INET, SOCK_STREAM, 0)), m_port(port), m_isRunning(true) {
+  if (m_socket < 0) {
+    throw std::runtime_error("metrics server, create socket failed");
+  }
+  const int enable = 1;
+  setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+  sockaddr_in socketAddress{};
+  socketAddress.sin_family = AF_INET;
+  socketAddress.sin_port = htons(port);
+  if (inet_pton(AF_INET, address.c_str(), &socketAddress.sin_addr) != 1) {
+    close(m_socket);
+    throw std::runtime_error(fmt::format("metrics server, invalid address: {}", address));
+  }
+  socklen_t length = sizeof(socketAddress);
+  if (bind(m_socket, reinterpret_cast<sockaddr*>(&socketAddress), sizeof(socketAddress)) != 0 || listen(m_socket, SOMAXCONN) != 0 ||
+      getsockname(m_socket, reinterpret_cast<sockaddr*>(&socketAddress), &length) != 0) {
+    close(m_socket);
+    throw std::runtime_error(fmt::format("metrics server, bind failed: {}:{}", address, port));
+  }
+  m_port = ntohs(socketAddress.sin_port);
+  m_thread = std::thread([this]() { worker(); });
+  if (!setThreadAffinity(m_thread.native_handle(), cores)) {
+    Logger::warn(LABEL, "set thread affinity failed, cores: {}", colored(RED, "{}", formatCores(cores)));
+  }
+  Logger::info(LABEL, "listening, address: {}, port: {}", colored(GREEN, "{}", address), colored(GREEN, "{}", m_port));
+}
+
+MetricsServer::~MetricsServer() {
+  m_isRunning = false;
+  m_thread.join();
+  close(m_socket);
+}
+
+int MetricsServer::port() const { return m_port; }
+
+void MetricsServer::worker() {
+  pollfd descriptor{m_socket, POLLIN, 0};
+  while (m_isRunning) {
+    if (poll(&descriptor, 1, METRICS_POLL_INTERVAL.count()) <= 0) {
+      continue;
+    }
+    const auto client = accept(m_socket, nullptr, nullptr);
+    if (client < 0) {
+      continue;
+    }
+    handle(client);
+    close(client);
+  }
+}
+
+void MetricsServer::handle(const int client) {
+  const timeval timeout{METRICS_CLIENT_TIMEOUT.count() / 1000, (METRICS_CLIENT_TIMEOUT.count() % 1000) * 1000};
+  // single worker thread, stalled client must not block other scrapes
+  setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+  std::string request;
+  char buffer[REQUEST_MAX_SIZE];
+  while (request.size() < REQUEST_MAX_SIZE && request.find("\r\n\r\n") == std::string::npos) {
+    const auto result = recv(client, buffer, sizeof(buffer), 0);
+    if (result <= 0) {
+      return;
+    }
+    request.append(buffer, result);
+  }
+
+  if (request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET /metrics?", 0) == 0) {
+    sendAll(client, getResponse("200 OK", Metrics::format()));
+  } else {
+    LOG_DEBUG(LABEL, "not found: {}", request.substr(0, request.find("\r\n")));
+    sendAll(client, getResponse("404 Not Found", "not found\n"));
+  }
+}
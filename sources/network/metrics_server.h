@@ -0,0 +1,27 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// minimal http server, GET /metrics returns Metrics::format() in prometheus text format
+class MetricsServer {
+ public:
+  MetricsServer(const std::string& address, const int port, const std::vector<int>& cores);
+  ~MetricsServer();
+
+  MetricsServer(const MetricsServer&) = delete;
+  MetricsServer& operator=(const MetricsServer&) = delete;
+
+  int port() const;
+
+ private:
+  void worker();
+  void handle(const int client);
+
+  int m_socket;
+  int m_port;
+  std::atomic<bool> m_isRunning;
+  std::thread m_thread;
+};
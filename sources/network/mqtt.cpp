@@ -1,83 +1,125 @@
 #include "mqtt.h"
 
 #include <logger.h>
+#include <metrics.h>
+#include <utils/thread_utils.h>
 #include <utils/utils.h>
 
+#include <algorithm>
+
 constexpr auto LABEL = "mqtt";
 constexpr auto QOS_SUB = 2;
 constexpr auto QUEUE_MAX_SIZE = 1000;
-constexpr auto LOOP_TIMEOUT = std::chrono::milliseconds(10);
+constexpr auto MAX_IN_FLIGHT = 32;
 constexpr auto RECONNECT_INTERVAL = std::chrono::seconds(5);
 constexpr auto CONNECT_TIMEOUT = std::chrono::seconds(5);
 constexpr auto KEEP_ALIVE = std::chrono::seconds(60);
 
+Mqtt::PublishListener::PublishListener(Mqtt& mqtt) : m_mqtt(mqtt) {}
+
+void Mqtt::PublishListener::on_failure(const mqtt::token& token) {
+  Logger::warn(LABEL, "publish failed, code: {}", token.get_return_code());
+  m_mqtt.onPublished();
+}
+
+void Mqtt::PublishListener::on_success(const mqtt::token&) { m_mqtt.onPublished(); }
+
 Mqtt::Mqtt(const Config& config)
-    : m_config(config), m_client(config.mqttUrl(), "sdr-scanner"), m_isRunning(true), m_thread([this, config]() {
-        Logger::info(LABEL, "started");
-        connect();
-        while (m_isRunning) {
-          if (m_client.is_connected()) {
-            std::shared_ptr<const mqtt::message> message;
-            while (m_client.try_consume_message_for(&message, LOOP_TIMEOUT) && message) {
-              onMessage(message->get_topic(), message->get_payload());
-            }
-            while (m_isRunning && !m_messages.empty()) {
-              const auto& [topic, data, qos] = m_messages.front();
-              m_client.publish(topic, data.data(), data.size(), qos, false);
-              std::unique_lock lock(m_mutex);
-              m_messages.pop();
-            }
-          } else {
-            onDisconnected();
-            while (m_isRunning && !m_client.is_connected()) {
-              Logger::info(LABEL, "reconnecting...");
-              connect();
-              if (!m_client.is_connected()) {
-                std::this_thread::sleep_for(RECONNECT_INTERVAL);
-              }
-            }
-          }
+    : m_config(config), m_client(config.mqttUrl(), "sdr-scanner"), m_publishListener(*this), m_isRunning(true), m_isConnectionLost(false), m_isSending(false), m_inFlight(0), m_dropped(0), m_nextCallbackId(0) {
+  m_client.set_connection_lost_handler([this](const std::string&) { onDisconnected(); });
+  m_client.set_message_callback([this](mqtt::const_message_ptr message) { onMessage(message->get_topic(), message->get_payload()); });
+  m_thread = std::thread([this]() {
+    Logger::info(LABEL, "started");
+    bool isFirst = true;
+    while (m_isRunning) {
+      if (!m_client.is_connected()) {
+        if (!isFirst) {
+          Logger::info(LABEL, "reconnecting...");
         }
-        Logger::info(LABEL, "stopped");
-      }) {}
+        connect();
+        isFirst = false;
+      }
+      std::unique_lock lock(m_mutex);
+      m_cv.wait_for(lock, RECONNECT_INTERVAL, [this]() { return !m_isRunning || m_isConnectionLost; });
+      m_isConnectionLost = false;
+    }
+    Logger::info(LABEL, "stopped");
+  });
+  if (!setThreadAffinity(m_thread.native_handle(), config.housekeepingCores())) {
+    Logger::warn(LABEL, "set thread affinity failed, cores: {}", colored(RED, "{}", formatCores(config.housekeepingCores())));
+  }
+}
 
 Mqtt::~Mqtt() {
-  m_isRunning = false;
+  {
+    std::unique_lock lock(m_mutex);
+    m_isRunning = false;
+    m_cv.notify_all();
+  }
   m_thread.join();
   if (m_client.is_connected()) {
-    m_client.disconnect();
+    m_client.disconnect()->wait();
   }
 }
 
-void Mqtt::publish(const std::string& topic, const std::string& data, int qos) {
-  std::unique_lock lock(m_mutex);
-  if (m_messages.size() < QUEUE_MAX_SIZE) {
-    m_messages.emplace(topic, std::vector<uint8_t>{data.begin(), data.end()}, qos);
-    Logger::trace(LABEL, "queue size: {}", m_messages.size());
+void Mqtt::publish(const std::string& topic, std::string&& data, int qos, const std::string& metric) {
+  publish(topic, std::make_shared<const std::string>(std::move(data)), qos, metric);
+}
+
+void Mqtt::publish(const std::string& topic, std::shared_ptr<const std::string> data, int qos, const std::string& metric) {
+  // message keeps reference to payload, no copy until client serializes it
+  auto message = mqtt::make_message(topic, mqtt::binary_ref(std::move(data)), qos, false);
+  std::function<void(const std::string&, const std::string&)> callback;
+  bool isQueued = false;
+  size_t queueSize = 0;
+  {
+    std::unique_lock lock(m_mutex);
+    callback = m_publishCallback;
+    isQueued = m_messages.size() < QUEUE_MAX_SIZE;
+    if (isQueued) {
+      m_messages.push_back(message);
+      queueSize = m_messages.size();
+    } else if (m_dropped++ % QUEUE_MAX_SIZE == 0) {
+      Logger::warn(LABEL, "queue full, dropped messages: {}", m_dropped);
+    }
+  }
+  if (callback) {
+    callback(topic, message->get_payload_str());
+  }
+  if (isQueued) {
+    Metrics::increment(metric.empty() ? getPublishedMetric(topic) : metric, message->get_payload().size());
+    Metrics::set("mqtt_queue_size", queueSize);
+    LOG_TRACE(LABEL, "queue size: {}", queueSize);
+  } else {
+    Metrics::increment("mqtt_dropped_total");
   }
+  sendMessages();
 }
 
-void Mqtt::publish(const std::string& topic, const std::vector<uint8_t>& data, int qos) {
-  std::unique_lock lock(m_mutex);
-  if (m_messages.size() < QUEUE_MAX_SIZE) {
-    m_messages.emplace(topic, data, qos);
-    Logger::trace(LABEL, "queue size: {}", m_messages.size());
+int Mqtt::setMessageCallback(const std::string& topic, std::function<void(const std::string&)> callback) {
+  int id = 0;
+  {
+    std::unique_lock lock(m_mutex);
+    id = m_nextCallbackId++;
+    m_callbacks.emplace_back(id, topic, callback);
   }
+  subscribe(topic);
+  return id;
 }
 
-void Mqtt::publish(const std::string& topic, const std::vector<uint8_t>&& data, int qos) {
+void Mqtt::removeMessageCallback(int id) {
+  // topic stays subscribed, messages without callback are ignored
   std::unique_lock lock(m_mutex);
-  if (m_messages.size() < QUEUE_MAX_SIZE) {
-    m_messages.emplace(topic, std::move(data), qos);
-    Logger::trace(LABEL, "queue size: {}", m_messages.size());
-  }
+  m_callbacks.erase(std::remove_if(m_callbacks.begin(), m_callbacks.end(), [id](const auto& callback) { return std::get<0>(callback) == id; }), m_callbacks.end());
 }
 
-void Mqtt::setMessageCallback(const std::string& topic, std::function<void(const std::string&)> callback) {
-  subscribe(topic);
-  m_callbacks.emplace_back(topic, callback);
+void Mqtt::setPublishCallback(std::function<void(const std::string&, const std::string&)> callback) {
+  std::unique_lock lock(m_mutex);
+  m_publishCallback = callback;
 }
 
+std::string Mqtt::getPublishedMetric(const std::string& topic) { return fmt::format("mqtt_published_bytes_total{{topic=\"{}\"}}", topic); }
+
 void Mqtt::connect() {
   mqtt::ssl_options ssl_options;
   ssl_options.ca_path("/etc/ssl/certs");
@@ -91,11 +133,16 @@ void Mqtt::connect() {
                            .connect_timeout(CONNECT_TIMEOUT)
                            .automatic_reconnect(false)
                            .clean_session(true)
+                           .max_inflight(MAX_IN_FLIGHT)
                            .finalize();
 
   try {
-    const auto response = m_client.connect(options);
-    if (response.is_session_present()) {
+    const auto token = m_client.connect(options);
+    if (!token->wait_for(CONNECT_TIMEOUT + std::chrono::seconds(1))) {
+      Logger::warn(LABEL, "connect timeout");
+      return;
+    }
+    if (token->get_connect_response().is_session_present()) {
       Logger::info(LABEL, "session already present");
     } else {
       Logger::info(LABEL, "new session created");
@@ -110,41 +157,96 @@ void Mqtt::connect() {
 
 void Mqtt::onConnected() {
   Logger::info(LABEL, "connected");
-  std::unique_lock lock(m_mutex);
-
-  for (const auto& topic : m_topics) {
+  std::set<std::string> topics;
+  {
+    std::unique_lock lock(m_mutex);
+    m_inFlight = 0;
+    m_topics.insert(m_waitingTopics.begin(), m_waitingTopics.end());
+    m_waitingTopics.clear();
+    topics = m_topics;
+  }
+  for (const auto& topic : topics) {
     Logger::info(LABEL, "subscribe: {}", colored(GREEN, "{}", topic));
     m_client.subscribe(topic, QOS_SUB);
   }
+  sendMessages();
+}
 
-  for (const auto& topic : m_waitingTopics) {
-    Logger::info(LABEL, "subscribe: {}", colored(GREEN, "{}", topic));
-    m_client.subscribe(topic, QOS_SUB);
-    m_topics.insert(topic);
+void Mqtt::onDisconnected() {
+  Logger::info(LABEL, "disconnected");
+  std::unique_lock lock(m_mutex);
+  m_inFlight = 0;
+  m_isConnectionLost = true;
+  m_cv.notify_all();
+}
+
+void Mqtt::onPublished() {
+  {
+    std::unique_lock lock(m_mutex);
+    m_inFlight = std::max(0, m_inFlight - 1);
   }
-  m_waitingTopics.clear();
+  sendMessages();
 }
 
-void Mqtt::onDisconnected() { Logger::info(LABEL, "disconnected"); }
+void Mqtt::sendMessages() {
+  {
+    // single sender hands messages to client in queue order, it also sends messages queued meanwhile
+    std::unique_lock lock(m_mutex);
+    if (m_isSending) {
+      return;
+    }
+    m_isSending = true;
+  }
+  while (true) {
+    mqtt::message_ptr message;
+    {
+      std::unique_lock lock(m_mutex);
+      if (!m_isRunning || !m_client.is_connected() || MAX_IN_FLIGHT <= m_inFlight || m_messages.empty()) {
+        m_isSending = false;
+        return;
+      }
+      message = std::move(m_messages.front());
+      m_messages.pop_front();
+      Metrics::set("mqtt_queue_size", m_messages.size());
+      m_inFlight++;
+    }
+    try {
+      m_client.publish(message, nullptr, m_publishListener);
+    } catch (const mqtt::exception& exception) {
+      Logger::warn(LABEL, "publish exception: {}", exception.what());
+      std::unique_lock lock(m_mutex);
+      m_inFlight = std::max(0, m_inFlight - 1);
+    }
+  }
+}
 
 void Mqtt::subscribe(const std::string& topic) {
-  std::unique_lock lock(m_mutex);
-  if (m_client.is_connected()) {
-    if (m_topics.count(topic) == 0) {
-      Logger::info(LABEL, "subscribe: {}", colored(GREEN, "{}", topic));
-      m_client.subscribe(topic, QOS_SUB);
-      m_topics.insert(topic);
+  {
+    std::unique_lock lock(m_mutex);
+    if (!m_client.is_connected()) {
+      m_waitingTopics.insert(topic);
+      return;
+    }
+    if (!m_topics.insert(topic).second) {
+      return;
     }
-  } else {
-    m_waitingTopics.insert(topic);
   }
+  Logger::info(LABEL, "subscribe: {}", colored(GREEN, "{}", topic));
+  m_client.subscribe(topic, QOS_SUB);
 }
 
 void Mqtt::onMessage(const std::string& topic, const std::string& data) {
-  Logger::debug(LABEL, "topic: {}, data: {}", topic, data);
-  for (auto& [callbackTopic, callback] : m_callbacks) {
-    if (topic == callbackTopic) {
-      callback(data);
+  LOG_DEBUG(LABEL, "topic: {}, data: {}", topic, data);
+  std::vector<std::function<void(const std::string&)>> callbacks;
+  {
+    std::unique_lock lock(m_mutex);
+    for (const auto& [id, callbackTopic, callback] : m_callbacks) {
+      if (topic == callbackTopic) {
+        callbacks.push_back(callback);
+      }
     }
   }
+  for (const auto& callback : callbacks) {
+    callback(data);
+  }
 }
@@ -1,41 +1,69 @@
 #pragma once
 
 #include <config.h>
-#include <mqtt/client.h>
+#include <mqtt/async_client.h>
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <functional>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <set>
 #include <string>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 class Mqtt {
+  class PublishListener : public mqtt::iaction_listener {
+   public:
+    PublishListener(Mqtt& mqtt);
+
+    void on_failure(const mqtt::token& token) override;
+    void on_success(const mqtt::token& token) override;
+
+   private:
+    Mqtt& m_mqtt;
+  };
+
  public:
   Mqtt(const Config& config);
   ~Mqtt();
 
-  void publish(const std::string& topic, const std::string& data, int qos = 0);
-  void publish(const std::string& topic, const std::vector<uint8_t>& data, int qos = 0);
-  void publish(const std::string& topic, const std::vector<uint8_t>&& data, int qos = 0);
-  void setMessageCallback(const std::string& topic, std::function<void(const std::string&)> callback);
+  // metric is published bytes counter name from getPublishedMetric, precomputed by frequent publishers
+  void publish(const std::string& topic, std::string&& data, int qos = 0, const std::string& metric = "");
+  void publish(const std::string& topic, std::shared_ptr<const std::string> data, int qos = 0, const std::string& metric = "");
+  int setMessageCallback(const std::string& topic, std::function<void(const std::string&)> callback);
+  void removeMessageCallback(int id);
+  void setPublishCallback(std::function<void(const std::string&, const std::string&)> callback);
+
+  static std::string getPublishedMetric(const std::string& topic);
 
  private:
   void connect();
   void onConnected();
   void onDisconnected();
   void onMessage(const std::string& topic, const std::string& data);
+  void onPublished();
+  void sendMessages();
   void subscribe(const std::string& topic);
 
   const Config& m_config;
-  mqtt::client m_client;
+  mqtt::async_client m_client;
+  PublishListener m_publishListener;
   std::atomic_bool m_isRunning;
-  std::thread m_thread;
+  bool m_isConnectionLost;
+  bool m_isSending;
   std::mutex m_mutex;
-  std::queue<std::tuple<std::string, std::vector<uint8_t>, int>> m_messages;
+  std::condition_variable m_cv;
+  std::deque<mqtt::message_ptr> m_messages;
+  int m_inFlight;
+  uint64_t m_dropped;
   std::set<std::string> m_topics;
   std::set<std::string> m_waitingTopics;
-  std::vector<std::pair<std::string, std::function<void(const std::string&)>>> m_callbacks;
+  int m_nextCallbackId;
+  std::vector<std::tuple<int, std::string, std::function<void(const std::string&)>>> m_callbacks;
+  std::function<void(const std::string&, const std::string&)> m_publishCallback;
+  std::thread m_thread;
 };
@@ -0,0 +1,39 @@
+#include "payload_pool.h"
+
+PayloadPool::PayloadPool(const int capacity) : m_capacity(capacity), m_state(std::make_shared<State>()) { m_state->m_allocated = 0; }
+
+std::shared_ptr<std::string> PayloadPool::get(const size_t size) {
+  std::unique_ptr<std::string> buffer;
+  {
+    std::unique_lock lock(m_state->m_mutex);
+    if (m_state->m_buffers.empty()) {
+      m_state->m_allocated++;
+    } else {
+      buffer = std::move(m_state->m_buffers.back());
+      m_state->m_buffers.pop_back();
+    }
+  }
+  if (!buffer) {
+    buffer = std::make_unique<std::string>();
+  }
+  buffer->resize(size);
+  const auto capacity = m_capacity;
+  return std::shared_ptr<std::string>(buffer.release(), [state = m_state, capacity](std::string* buffer) {
+    std::unique_lock lock(state->m_mutex);
+    if (static_cast<int>(state->m_buffers.size()) < capacity) {
+      state->m_buffers.emplace_back(buffer);
+    } else {
+      delete buffer;
+    }
+  });
+}
+
+int PayloadPool::available() const {
+  std::unique_lock lock(m_state->m_mutex);
+  return m_state->m_buffers.size();
+}
+
+uint64_t PayloadPool::allocated() const {
+  std::unique_lock lock(m_state->m_mutex);
+  return m_state->m_allocated;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// reusable payload buffers, released buffer returns to pool with its capacity
+// buffers keep pool state alive, so they may outlive pool, e.g. in mqtt queue
+class PayloadPool {
+  struct State {
+    std::mutex m_mutex;
+    std::vector<std::unique_ptr<std::string>> m_buffers;
+    uint64_t m_allocated;
+  };
+
+ public:
+  PayloadPool(const int capacity);
+
+  // buffer of given size, content is not initialized
+  std::shared_ptr<std::string> get(const size_t size);
+
+  int available() const;
+  uint64_t allocated() const;
+
+ private:
+  const int m_capacity;
+  std::shared_ptr<State> m_state;
+};
@@ -15,7 +15,7 @@ constexpr auto LABEL = "remote";
 
 using namespace std::placeholders;
 
-RemoteController::RemoteController(const Config& config, const std::string& id, Mqtt& mqtt, std::function<void(const nlohmann::json&)> configCallback)
+RemoteController::RemoteController(const Snapshot<Config>& config, const std::string& id, Mqtt& mqtt, std::function<void(const nlohmann::json&)> configCallback)
     : m_config(config), m_id(id), m_mqtt(mqtt), m_configCallback(configCallback) {
   mqtt.setMessageCallback(fmt::format("sdr/{}", LIST), std::bind(&RemoteController::listCallback, this, _1));
   mqtt.setMessageCallback(fmt::format("sdr/{}/{}", CONFIG, m_id), std::bind(&RemoteController::configCallback, this, _1));
@@ -26,7 +26,7 @@ RemoteController::RemoteController(const Config& config, const std::string& id,
 
 void RemoteController::listCallback(const std::string&) {
   Logger::info(LABEL, "received list");
-  m_mqtt.publish(fmt::format("sdr/{}/{}", STATUS, m_id), m_config.json().dump(), 2);
+  m_mqtt.publish(fmt::format("sdr/{}/{}", STATUS, m_id), m_config.load()->json().dump(), 2);
 }
 
 void RemoteController::configCallback(const std::string& data) {
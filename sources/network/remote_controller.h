@@ -2,13 +2,14 @@
 
 #include <config.h>
 #include <network/mqtt.h>
+#include <utils/snapshot.h>
 
 #include <functional>
 #include <nlohmann/json.hpp>
 
 class RemoteController {
  public:
-  RemoteController(const Config& config, const std::string& id, Mqtt& mqtt, std::function<void(const nlohmann::json&)> configCallback);
+  RemoteController(const Snapshot<Config>& config, const std::string& id, Mqtt& mqtt, std::function<void(const nlohmann::json&)> configCallback);
 
  private:
   void listCallback(const std::string& data);
@@ -16,7 +17,7 @@ class RemoteController {
   void manualRecordingCallback(const std::string& data);
   void restartCallback(const std::string& data);
 
-  const Config& m_config;
+  const Snapshot<Config>& m_config;
   const std::string m_id;
   Mqtt& m_mqtt;
   std::function<void(const nlohmann::json&)> m_configCallback;
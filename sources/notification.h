@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <mutex>
 #include <optional>
@@ -17,10 +18,12 @@ class Notification {
     m_cv.notify_all();
   }
 
-  T wait() {
+  std::optional<T> wait(const std::chrono::milliseconds timeout) {
     std::unique_lock<std::mutex> lock(m_mutex);
-    m_cv.wait(lock, [this]() { return m_value.has_value(); });
-    T value = std::move(m_value.value());
+    if (!m_cv.wait_for(lock, timeout, [this]() { return m_value.has_value(); })) {
+      return std::nullopt;
+    }
+    std::optional<T> value = std::move(m_value);
     m_value = std::nullopt;
     return value;
   }
@@ -11,6 +11,7 @@ class PerformanceLogger {
  private:
   const std::string m_label;
   const std::string m_name;
+  const std::string m_metric;
   uint64_t m_samplesCount;
   std::chrono::milliseconds m_lastLog;
 };
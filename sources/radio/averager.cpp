@@ -1,61 +1,85 @@
 #include "averager.h"
 
-#include <utils/utils.h>
+#include <utils/radio_utils.h>
+#include <utils/simd_utils.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
+#include <new>
 
-Averager::Averager(int size, int groupSize) : m_size(size), m_groupSize(groupSize), m_sum(size, 0.0), m_average(size, 0.0), m_frames(0) {
-  for (int i = 0; i < m_groupSize; ++i) {
-    m_buffers.emplace_back(m_size, 0.0);
+namespace {
+constexpr auto ALIGNMENT = 64;
+constexpr auto FLOATS_PER_ALIGNMENT = ALIGNMENT / static_cast<int>(sizeof(float));
+constexpr auto RESYNC_GROUPS = 64;  // recompute sum from ring every n full groups
+
+float* allocate(const int size) {
+  auto data = static_cast<float*>(std::aligned_alloc(ALIGNMENT, std::max(ALIGNMENT, static_cast<int>(sizeof(float)) * size)));
+  if (!data) {
+    throw std::bad_alloc();
   }
-  updateAverage();
+  return data;
+}
+}  // namespace
+
+Averager::Averager(int size, int groupSize)
+    : m_size(size),
+      m_groupSize(groupSize),
+      m_stride((size + FLOATS_PER_ALIGNMENT - 1) / FLOATS_PER_ALIGNMENT * FLOATS_PER_ALIGNMENT),
+      m_data(allocate(m_stride * groupSize), std::free),
+      m_sum(size, 0.0),
+      m_average(size, 0.0),
+      m_isAverageValid(false),
+      m_head(0),
+      m_frames(0),
+      m_pushes(0) {
+  reset();
 }
 
 void Averager::push(const float* data) {
   m_frames = std::min(m_frames + 1, m_groupSize);
-  Buffer buffer = std::move(m_buffers.front());
-  subtract(buffer.data());
-  m_buffers.pop_front();
-
-  std::memcpy(buffer.data(), data, sizeof(float) * m_size);
-  add(buffer.data());
-  m_buffers.push_back(std::move(buffer));
-
-  updateAverage();
+  replaceRow(m_sum.data(), rowData(m_head), data, m_size);
+  m_head = (m_head + 1) % m_groupSize;
+  if (++m_pushes == RESYNC_GROUPS * m_groupSize) {
+    m_pushes = 0;
+    resync();
+  }
+  m_isAverageValid = false;
 }
 
 void Averager::reset() {
   std::fill(m_sum.begin(), m_sum.end(), 0);
-  for (auto& buffer : m_buffers) {
-    std::fill(buffer.begin(), buffer.end(), 0);
-  }
+  std::memset(m_data.get(), 0, sizeof(float) * m_stride * m_groupSize);
+  m_head = 0;
   m_frames = 0;
-  updateAverage();
+  m_pushes = 0;
+  m_isAverageValid = false;
 }
 
-const std::vector<float>& Averager::average() const { return m_average; }
-
-const std::deque<Averager::Buffer>& Averager::data() const { return m_buffers; }
-
-void Averager::add(const float* data) {
-  for (int i = 0; i < m_size; ++i) {
-    m_sum[i] += data[i];
+const std::vector<float>& Averager::average() const {
+  if (!m_isAverageValid) {
+    if (m_groupSize <= m_frames) {
+      divide(m_sum.data(), m_average.data(), m_size, m_groupSize);
+    } else {
+      setNoData(m_average.data(), m_size);
+    }
+    m_isAverageValid = true;
   }
+  return m_average;
 }
 
-void Averager::subtract(const float* data) {
-  for (int i = 0; i < m_size; ++i) {
-    m_sum[i] -= data[i];
-  }
-}
+int Averager::rows() const { return m_groupSize; }
 
-void Averager::updateAverage() {
-  const auto isReady = m_groupSize <= m_frames;
-  if (isReady) {
-    for (int i = 0; i < m_size; ++i) {
-      m_average[i] = m_sum[i] / m_groupSize;
+const float* Averager::row(const int index) const { return rowData((m_head + index) % m_groupSize); }
+
+float* Averager::rowData(const int index) const { return m_data.get() + index * m_stride; }
+
+void Averager::resync() {
+  std::fill(m_sum.begin(), m_sum.end(), 0.0f);
+  for (int i = 0; i < m_groupSize; ++i) {
+    const auto data = rowData(i);
+    for (int j = 0; j < m_size; ++j) {
+      m_sum[j] += data[j];
     }
-  } else {
-    setNoData(m_average.data(), m_size);
   }
-}
\ No newline at end of file
+}
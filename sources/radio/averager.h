@@ -2,28 +2,32 @@
 
 #include <radio/help_structures.h>
 
-#include <deque>
+#include <memory>
 #include <vector>
 
+// moving average of last groupSize frames, frames are kept in one contiguous aligned ring
+// running sum is recomputed from ring periodically, so rounding errors do not accumulate
 class Averager {
-  using Buffer = std::vector<float>;
-
  public:
   Averager(int size, int groupSize);
   void push(const float* data);
   void reset();
   const std::vector<float>& average() const;
-  const std::deque<Buffer>& data() const;
+  int rows() const;
+  const float* row(const int index) const;  // 0 is the oldest frame
 
  private:
-  void add(const float* data);
-  void subtract(const float* data);
-  void updateAverage();
+  float* rowData(const int index) const;
+  void resync();
 
   const int m_size;
   const int m_groupSize;
+  const int m_stride;
+  std::unique_ptr<float, void (*)(void*)> m_data;
   std::vector<float> m_sum;
-  std::vector<float> m_average;
-  std::deque<Buffer> m_buffers;
+  mutable std::vector<float> m_average;
+  mutable bool m_isAverageValid;
+  int m_head;
   int m_frames;
-};
\ No newline at end of file
+  int m_pushes;
+};
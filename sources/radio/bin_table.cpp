@@ -0,0 +1,43 @@
+#include "bin_table.h"
+
+#include <algorithm>
+
+BinTable::BinTable(const int size, const Frequency sampleRate, const FrequencyRange& range, const std::vector<FrequencyRange>& ignoredRanges)
+    : m_shifts(size), m_frequencies(size), m_mask((size + 7) / 8, 0) {
+  const auto center = (range.first + range.second) / 2;
+  const auto step = static_cast<double>(sampleRate) / size;
+  for (int i = 0; i < size; ++i) {
+    m_shifts[i] = static_cast<Frequency>(step * (i + 0.5)) - sampleRate / 2;
+    m_frequencies[i] = center + m_shifts[i];
+  }
+
+  const auto setAllowed = [this](const int begin, const int end, const bool isAllowed) {
+    for (int i = begin; i < end; ++i) {
+      if (isAllowed) {
+        m_mask[i / 8] |= 1 << (i % 8);
+      } else {
+        m_mask[i / 8] &= ~(1 << (i % 8));
+      }
+    }
+  };
+  const auto getIndexes = [this](const FrequencyRange& r) {
+    const auto begin = std::lower_bound(m_frequencies.begin(), m_frequencies.end(), r.first) - m_frequencies.begin();
+    const auto end = std::upper_bound(m_frequencies.begin(), m_frequencies.end(), r.second) - m_frequencies.begin();
+    return std::make_pair(static_cast<int>(begin), static_cast<int>(end));
+  };
+
+  const auto [begin, end] = getIndexes(range);
+  setAllowed(begin, end, true);
+  for (const auto& ignoredRange : ignoredRanges) {
+    const auto [ignoredBegin, ignoredEnd] = getIndexes(ignoredRange);
+    setAllowed(ignoredBegin, ignoredEnd, false);
+  }
+}
+
+bool BinTable::isAllowed(const int index) const { return m_mask[index / 8] & (1 << (index % 8)); }
+
+Frequency BinTable::frequency(const int index) const { return m_frequencies[index]; }
+
+Frequency BinTable::shift(const int index) const { return m_shifts[index]; }
+
+const uint8_t* BinTable::mask() const { return m_mask.data(); }
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <radio/help_structures.h>
+
+#include <cstdint>
+#include <vector>
+
+// per tuned range lookup of fft bins: allowed bins bitmask, bin frequency and bin shift from center frequency
+class BinTable {
+ public:
+  BinTable(const int size, const Frequency sampleRate, const FrequencyRange& range, const std::vector<FrequencyRange>& ignoredRanges);
+
+  bool isAllowed(const int index) const;
+  Frequency frequency(const int index) const;
+  Frequency shift(const int index) const;
+  const uint8_t* mask() const;
+
+ private:
+  std::vector<Frequency> m_shifts;
+  std::vector<Frequency> m_frequencies;
+  std::vector<uint8_t> m_mask;
+};
@@ -0,0 +1,263 @@
+#include "channelizer.h"
+
+#include <config.h>
+#include <gnuradio/filter/firdes.h>
+#include <logger.h>
+#include <radio/blocks/source.h>
+#include <utils/radio_utils.h>
+#include <utils/simd_utils.h>
+#include <utils/utils.h>
+
+#include <cstring>
+
+constexpr auto LABEL = "channelizer";
+constexpr auto MIN_IFFT_SIZE = 64;
+constexpr auto OVERLAP_FACTOR = 4;
+
+namespace {
+std::vector<float> getTaps(const Frequency sampleRate, const Frequency bandwidth) {
+  // same band edges as default rational resampler taps: pass 0.4, stop 0.5 of output sample rate
+  return gr::filter::firdes::low_pass(1.0, sampleRate, 0.45 * bandwidth, 0.1 * bandwidth);
+}
+
+int getIfftSize(const int overlap) {
+  int size = MIN_IFFT_SIZE;
+  while (size < OVERLAP_FACTOR * overlap) {
+    size = size << 1;
+  }
+  return size;
+}
+
+int64_t modulo(const int64_t value, const int64_t n) { return ((value % n) + n) % n; }
+
+int getRingBlocks(const int preTriggerBlocks) {
+  // backfilled channel catches up with live data, extra half of pre trigger covers its lag
+  return preTriggerBlocks == 0 ? 0 : preTriggerBlocks + preTriggerBlocks / 2 + 2;
+}
+}  // namespace
+
+Channelizer::Channel::Channel() : m_isActive(false), m_bin(0), m_nextBlock(0), m_phase(1.0f, 0.0f), m_phaseIncrement(1.0f, 0.0f) {}
+
+Channelizer::Channelizer(
+    const Frequency sampleRate,
+    const Frequency bandwidth,
+    const int channelsCount,
+    const SampleFormat inputFormat,
+    const float inputScale,
+    const bool isSimpleComplexOutput,
+    const std::chrono::milliseconds preTrigger)
+    : gr::block(
+          "Channelizer",
+          gr::io_signature::make(1, 1, getSampleSize(inputFormat)),
+          gr::io_signature::make(channelsCount, channelsCount, isSimpleComplexOutput ? sizeof(SimpleComplex) : sizeof(gr_complex))),
+      m_sampleRate(sampleRate),
+      m_inputFormat(inputFormat),
+      m_inputScale(inputScale),
+      m_inputSize(getSampleSize(inputFormat)),
+      m_isSimpleComplexOutput(isSimpleComplexOutput),
+      m_decimation(std::max(1, sampleRate / bandwidth)),
+      m_taps(getTaps(sampleRate, bandwidth)),
+      m_overlap(roundUp(m_taps.size() - 1, m_decimation)),
+      m_ifftSize(getIfftSize(m_overlap / m_decimation)),
+      m_fftSize(m_ifftSize * m_decimation),
+      m_step(m_fftSize - m_overlap),
+      m_outputSize(m_step / m_decimation),
+      m_preTriggerBlocks(static_cast<int>((static_cast<int64_t>(sampleRate) * preTrigger.count() / 1000 + m_step - 1) / m_step)),
+      m_ringBlocks(getRingBlocks(m_preTriggerBlocks)),
+      m_settle(static_cast<int>(static_cast<int64_t>(sampleRate) * RETUNE_SETTLE_TIME.count() / 1000)),
+      m_retuneKey(pmt::string_to_symbol(RETUNE_TAG)),
+      m_fft(std::make_unique<gr::fft::fft_complex_fwd>(m_fftSize)),
+      m_ifft(std::make_unique<gr::fft::fft_complex_rev>(m_ifftSize)),
+      m_filter(m_ifftSize),
+      m_history(m_overlap, 0.0f),
+      m_output(isSimpleComplexOutput ? m_outputSize : 0),
+      m_ring(static_cast<size_t>(m_ringBlocks) * m_step * m_inputSize),
+      m_blocks(0),
+      m_retuneBlock(0),
+      m_channels(channelsCount),
+      m_produced(channelsCount, 0) {
+  Logger::info(
+      LABEL,
+      "taps: {}, fft: {}, ifft: {}, decimation: {}, output sample rate: {}, input format: {}, output format: {}",
+      colored(GREEN, "{}", m_taps.size()),
+      colored(GREEN, "{}", m_fftSize),
+      colored(GREEN, "{}", m_ifftSize),
+      colored(GREEN, "{}", m_decimation),
+      formatFrequency(m_sampleRate / m_decimation),
+      colored(GREEN, "{}", getSampleFormatName(m_inputFormat)),
+      colored(GREEN, "{}", getSampleFormatName(m_isSimpleComplexOutput ? SampleFormat::CS8 : SampleFormat::CF32)));
+  Logger::info(
+      LABEL,
+      "pre trigger: {}, history: {}",
+      colored(GREEN, "{} ms", preTrigger.count()),
+      colored(GREEN, "{:.1f} MB", m_ring.size() / (1024.0 * 1024.0)));
+
+  gr::fft::fft_complex_fwd fft(m_fftSize);
+  gr_complex* buffer = fft.get_inbuf();
+  std::fill(buffer, buffer + m_fftSize, gr_complex(0.0f, 0.0f));
+  std::copy(m_taps.begin(), m_taps.end(), buffer);
+  fft.execute();
+  for (int i = 0; i < m_ifftSize; ++i) {
+    const auto bin = modulo(i < m_ifftSize / 2 ? i : i - m_ifftSize, m_fftSize);
+    m_filter[i] = fft.get_outbuf()[bin] / static_cast<float>(m_fftSize);
+  }
+
+  set_output_multiple(m_outputSize);
+  set_relative_rate(1, m_decimation);
+}
+
+void Channelizer::forecast(int noutput_items, gr_vector_int& ninput_items_required) {
+  // backfilled channel catches up only if output space exceeds new input
+  std::unique_lock<std::mutex> lock(m_mutex);
+  uint64_t lag = 0;
+  for (const auto& channel : m_channels) {
+    if (channel.m_isActive) {
+      lag = std::max(lag, m_blocks - std::min(m_blocks, channel.m_nextBlock));
+    }
+  }
+  const auto blocks = noutput_items / m_outputSize - static_cast<int>(std::min<uint64_t>(lag, noutput_items / m_outputSize));
+  ninput_items_required[0] = std::max(1, blocks) * m_step;
+}
+
+int Channelizer::general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
+  const uint8_t* input_buf = static_cast<const uint8_t*>(input_items[0]);
+  const auto blocks = std::min(ninput_items[0] / m_step, noutput_items / m_outputSize);
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  const auto start = nitems_read(0);
+  get_tags_in_range(m_tags, 0, start, start + blocks * m_step, m_retuneKey);
+  if (!m_tags.empty()) {
+    // backfill starts at first block fully after retune and settle window
+    m_retuneBlock = m_blocks + (m_tags.back().offset - start + m_settle) / m_step + 1;
+  }
+
+  std::fill(m_produced.begin(), m_produced.end(), 0);
+  for (int i = 0; i < blocks; ++i) {
+    processBlock(input_buf + static_cast<size_t>(i) * m_step * m_inputSize, output_items, i * m_outputSize);
+  }
+  for (size_t i = 0; i < m_channels.size(); ++i) {
+    auto& channel = m_channels[i];
+    if (channel.m_isActive && channel.m_nextBlock < m_blocks) {
+      m_produced[i] = backfillChannel(channel, output_items[i], noutput_items / m_outputSize) * m_outputSize;
+    }
+    produce(i, m_produced[i]);
+  }
+  consume_each(blocks * m_step);
+  return WORK_CALLED_PRODUCE;
+}
+
+int Channelizer::getDecimation() const { return m_decimation; }
+
+bool Channelizer::isSimpleComplexOutput() const { return m_isSimpleComplexOutput; }
+
+bool Channelizer::isChannelActive(const int index) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  return m_channels[index].m_isActive;
+}
+
+std::chrono::milliseconds Channelizer::startChannel(const int index, const Frequency shift) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto& channel = m_channels[index];
+  const auto first = std::min(m_blocks, std::max(getOldestBlock(), m_retuneBlock));
+  const auto bin = std::lround(static_cast<double>(shift) * m_fftSize / m_sampleRate);
+  const auto residualShift = shift - static_cast<double>(bin) * m_sampleRate / m_fftSize;
+  channel.m_isActive = true;
+  channel.m_bin = bin;
+  channel.m_nextBlock = std::max(first, m_blocks - std::min<uint64_t>(m_blocks, m_preTriggerBlocks));
+  channel.m_phase = gr_complex(1.0f, 0.0f);
+  channel.m_phaseIncrement = std::polar(1.0f, static_cast<float>(-2.0 * M_PI * residualShift * m_decimation / m_sampleRate));
+  return std::chrono::milliseconds(static_cast<int64_t>(m_blocks - channel.m_nextBlock) * m_step * 1000 / m_sampleRate);
+}
+
+void Channelizer::stopChannel(const int index) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_channels[index].m_isActive = false;
+}
+
+void Channelizer::processBlock(const uint8_t* input, gr_vector_void_star& output_items, const int outputOffset) {
+  if (0 < m_ringBlocks) {
+    std::memcpy(getRingBlock(m_blocks), input, static_cast<size_t>(m_step) * m_inputSize);
+  }
+
+  bool isAnyLive = false;
+  for (const auto& channel : m_channels) {
+    isAnyLive |= channel.m_isActive && channel.m_nextBlock == m_blocks;
+  }
+  if (!isAnyLive) {
+    // only overlap of next block is needed
+    toComplex(input + static_cast<size_t>(m_step - m_overlap) * m_inputSize, m_history.data(), m_overlap, m_inputFormat, m_inputScale);
+    m_blocks++;
+    return;
+  }
+
+  gr_complex* buffer = m_fft->get_inbuf();
+  std::memcpy(buffer, m_history.data(), sizeof(gr_complex) * m_overlap);
+  toComplex(input, buffer + m_overlap, m_step, m_inputFormat, m_inputScale);
+  std::memcpy(m_history.data(), buffer + m_step, sizeof(gr_complex) * m_overlap);
+
+  m_fft->execute();
+  for (size_t i = 0; i < m_channels.size(); ++i) {
+    auto& channel = m_channels[i];
+    if (channel.m_isActive && channel.m_nextBlock == m_blocks) {
+      writeChannel(channel, m_blocks, output_items[i], outputOffset);
+      channel.m_nextBlock++;
+      m_produced[i] += m_outputSize;
+    }
+  }
+  m_blocks++;
+}
+
+int Channelizer::backfillChannel(Channel& channel, void* output, const int maxBlocks) {
+  const auto oldest = getOldestBlock();
+  if (channel.m_nextBlock < oldest) {
+    Logger::warn(LABEL, "history overrun, skipped blocks: {}", colored(YELLOW, "{}", oldest - channel.m_nextBlock));
+    channel.m_nextBlock = oldest;
+  }
+  gr_complex* buffer = m_fft->get_inbuf();
+  int count = 0;
+  for (; count < maxBlocks && channel.m_nextBlock < m_blocks; ++count) {
+    const auto block = channel.m_nextBlock;
+    toComplex(getRingBlock(block - 1) + static_cast<size_t>(m_step - m_overlap) * m_inputSize, buffer, m_overlap, m_inputFormat, m_inputScale);
+    toComplex(getRingBlock(block), buffer + m_overlap, m_step, m_inputFormat, m_inputScale);
+    m_fft->execute();
+    writeChannel(channel, block, output, count * m_outputSize);
+    channel.m_nextBlock++;
+  }
+  return count;
+}
+
+void Channelizer::writeChannel(Channel& channel, const uint64_t block, void* output, const int outputOffset) {
+  if (m_isSimpleComplexOutput) {
+    extractChannel(channel, block, m_output.data());
+    floatToInt8(reinterpret_cast<const float*>(m_output.data()), static_cast<int8_t*>(output) + 2 * outputOffset, 2 * m_outputSize, 127.0f);
+  } else {
+    extractChannel(channel, block, static_cast<gr_complex*>(output) + outputOffset);
+  }
+}
+
+void Channelizer::extractChannel(Channel& channel, const uint64_t block, gr_complex* output) {
+  const gr_complex* spectrum = m_fft->get_outbuf();
+  gr_complex* buffer = m_ifft->get_inbuf();
+  for (int i = 0; i < m_ifftSize; ++i) {
+    const auto bin = modulo(channel.m_bin + (i < m_ifftSize / 2 ? i : i - m_ifftSize), m_fftSize);
+    buffer[i] = spectrum[bin] * m_filter[i];
+  }
+  m_ifft->execute();
+
+  const auto blockStart = modulo(static_cast<int64_t>(block % m_fftSize) * m_step - m_overlap, m_fftSize);
+  const auto blockPhase = static_cast<double>(modulo(modulo(channel.m_bin, m_fftSize) * blockStart, m_fftSize)) / m_fftSize;
+  const auto blockRotation = std::polar(1.0f, static_cast<float>(-2.0 * M_PI * blockPhase));
+  const gr_complex* result = m_ifft->get_outbuf() + m_overlap / m_decimation;
+  for (int i = 0; i < m_outputSize; ++i) {
+    output[i] = result[i] * blockRotation * channel.m_phase;
+    channel.m_phase *= channel.m_phaseIncrement;
+  }
+  channel.m_phase /= std::abs(channel.m_phase);
+}
+
+uint64_t Channelizer::getOldestBlock() const {
+  // first block with its predecessor still in ring, predecessor gives overlap
+  return std::max<uint64_t>(1, m_blocks + 1 - std::min<uint64_t>(m_blocks, m_ringBlocks));
+}
+
+uint8_t* Channelizer::getRingBlock(const uint64_t block) { return m_ring.data() + (block % m_ringBlocks) * m_step * m_inputSize; }
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <gnuradio/block.h>
+#include <gnuradio/fft/fft.h>
+#include <radio/help_structures.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// fast convolution ddc, one shared forward fft per block and small inverse fft per active channel
+// input is in source sample format and converted to float while filling fft buffer
+// output is gr_complex or, if no resampling follows, SimpleComplex quantized same way as complex_to_interleaved_char
+// recent input blocks are kept in ring, started channel is backfilled from pre trigger time and then continues live
+// ring is used only from work thread, so it needs no locking
+class Channelizer : virtual public gr::block {
+  struct Channel {
+    Channel();
+
+    bool m_isActive;
+    int m_bin;
+    uint64_t m_nextBlock;
+    gr_complex m_phase;
+    gr_complex m_phaseIncrement;
+  };
+
+ public:
+  Channelizer(
+      const Frequency sampleRate,
+      const Frequency bandwidth,
+      const int channelsCount,
+      const SampleFormat inputFormat,
+      const float inputScale,
+      const bool isSimpleComplexOutput,
+      const std::chrono::milliseconds preTrigger);
+
+  void forecast(int noutput_items, gr_vector_int& ninput_items_required) override;
+  int general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+  int getDecimation() const;
+  bool isSimpleComplexOutput() const;
+  bool isChannelActive(const int index);
+  // returns duration of backfilled pre trigger data
+  std::chrono::milliseconds startChannel(const int index, const Frequency shift);
+  void stopChannel(const int index);
+
+ private:
+  void processBlock(const uint8_t* input, gr_vector_void_star& output_items, const int outputOffset);
+  int backfillChannel(Channel& channel, void* output, const int maxBlocks);
+  void writeChannel(Channel& channel, const uint64_t block, void* output, const int outputOffset);
+  void extractChannel(Channel& channel, const uint64_t block, gr_complex* output);
+  uint64_t getOldestBlock() const;
+  uint8_t* getRingBlock(const uint64_t block);
+
+  const Frequency m_sampleRate;
+  const SampleFormat m_inputFormat;
+  const float m_inputScale;
+  const int m_inputSize;
+  const bool m_isSimpleComplexOutput;
+  const int m_decimation;
+  const std::vector<float> m_taps;
+  const int m_overlap;
+  const int m_ifftSize;
+  const int m_fftSize;
+  const int m_step;
+  const int m_outputSize;
+  const int m_preTriggerBlocks;
+  const int m_ringBlocks;
+  const int m_settle;
+  const pmt::pmt_t m_retuneKey;
+  std::unique_ptr<gr::fft::fft_complex_fwd> m_fft;
+  std::unique_ptr<gr::fft::fft_complex_rev> m_ifft;
+  std::vector<gr_complex> m_filter;
+  std::vector<gr_complex> m_history;
+  std::vector<gr_complex> m_output;
+  std::vector<uint8_t> m_ring;
+  std::vector<gr::tag_t> m_tags;
+  uint64_t m_blocks;
+  uint64_t m_retuneBlock;
+  std::mutex m_mutex;
+  std::vector<Channel> m_channels;
+  std::vector<int> m_produced;
+};
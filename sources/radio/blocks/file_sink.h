@@ -1,5 +1,6 @@
 #pragma once
 
+#include <config.h>
 #include <gnuradio/sync_block.h>
 #include <logger.h>
 #include <radio/blocks/buffer.h>
@@ -13,25 +14,25 @@ class FileSink : public Buffer<T> {
   static constexpr auto LABEL = "file";
 
  public:
-  FileSink(const int itemSize, const bool flushable) : Buffer<T>("FileSink", itemSize), m_itemSize(itemSize), m_flushable(flushable), m_file(nullptr), m_isRecording(false), m_filename("") {}
+  FileSink(const int itemSize, const bool flushable)
+      : Buffer<T>("FileSink", itemSize, flushable ? FILE_SINK_BUFFER_SIZE : 0, Buffer<T>::Policy::DropNewest), m_itemSize(itemSize), m_flushable(flushable), m_file(nullptr), m_isRecording(false), m_filename("") {}
   ~FileSink() { stopRecording(); }
 
   int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star&) override {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    if (m_isRecording) {
-      if (m_flushable) {
+    if (m_flushable) {
+      if (m_isRecording) {
         Buffer<T>::push(static_cast<const T*>(input_items[0]), noutput_items);
-      } else {
+      }
+    } else {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      if (m_isRecording) {
         save(static_cast<const T*>(input_items[0]), noutput_items);
       }
     }
     return noutput_items;
   }
 
-  bool isRecording() {
-    std::unique_lock<std::mutex> lock(m_mutex);
-    return m_isRecording;
-  }
+  bool isRecording() { return m_isRecording; }
 
   void startRecording(const std::string& filename) {
     std::unique_lock<std::mutex> lock(m_mutex);
@@ -87,6 +88,6 @@ class FileSink : public Buffer<T> {
   const bool m_flushable;
   FILE* m_file;
   std::mutex m_mutex;
-  bool m_isRecording;
+  std::atomic_bool m_isRecording;
   std::string m_filename;
 };
@@ -0,0 +1,105 @@
+#include "file_source.h"
+
+#include <fcntl.h>
+#include <logger.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utils/radio_utils.h>
+#include <utils/utils.h>
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+constexpr auto LABEL = "source";
+constexpr auto MAX_OUTPUT_DURATION_MS = 10;
+
+namespace {
+SampleFormat getFileFormat(const std::string& path) {
+  const auto info = parseRawFileName(path);
+  if (!info) {
+    throw std::runtime_error("invalid replay file name: " + path);
+  }
+  return *parseSampleFormat(info->m_format);
+}
+}  // namespace
+
+FileSource::FileSource(const Device& device)
+    : gr::sync_block("FileSource", gr::io_signature::make(0, 0, 0), gr::io_signature::make(1, 1, getSampleSize(getFileFormat(device.m_replayFile)))),
+      Source(getFileFormat(device.m_replayFile)),
+      m_path(device.m_replayFile),
+      m_realTime(device.m_replayRealTime),
+      m_loop(device.m_replayLoop),
+      m_data(nullptr),
+      m_size(0),
+      m_items(0),
+      m_position(0),
+      m_produced(0) {
+  const auto info = parseRawFileName(m_path);
+  m_frequency = info->m_frequency;
+  m_sampleRate = info->m_sampleRate;
+  m_itemSize = getSampleSize(getSampleFormat());
+
+  const auto fd = open(m_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("open replay file failed: " + m_path);
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < m_itemSize) {
+    close(fd);
+    throw std::runtime_error("empty replay file: " + m_path);
+  }
+  m_size = st.st_size;
+  m_items = m_size / m_itemSize;
+  void* data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error("mmap replay file failed: " + m_path);
+  }
+  madvise(data, m_size, MADV_SEQUENTIAL);
+  m_data = static_cast<uint8_t*>(data);
+
+  Logger::info(
+      LABEL,
+      "replay file: {}, format: {}, frequency: {}, sample rate: {}, duration: {}, real time: {}, loop: {}",
+      colored(GREEN, "{}", m_path),
+      colored(GREEN, "{}", info->m_format),
+      formatFrequency(m_frequency),
+      formatFrequency(m_sampleRate),
+      colored(GREEN, "{:.2f} s", static_cast<double>(m_items) / m_sampleRate),
+      colored(GREEN, "{}", m_realTime),
+      colored(GREEN, "{}", m_loop));
+  set_max_noutput_items(std::max(1024, m_sampleRate / 1000 * MAX_OUTPUT_DURATION_MS));
+}
+
+FileSource::~FileSource() { munmap(m_data, m_size); }
+
+int FileSource::work(int noutput_items, gr_vector_const_void_star&, gr_vector_void_star& output_items) {
+  uint8_t* output = static_cast<uint8_t*>(output_items[0]);
+  addRetuneTag();
+  if (m_position == m_items) {
+    if (!m_loop) {
+      Logger::info(LABEL, "replay finished, samples: {}", colored(GREEN, "{}", m_produced));
+      return WORK_DONE;
+    }
+    m_position = 0;
+  }
+
+  const auto count = static_cast<int>(std::min(static_cast<size_t>(noutput_items), m_items - m_position));
+  if (m_realTime) {
+    std::this_thread::sleep_until(m_startTime + std::chrono::microseconds((m_produced + count) * 1000000 / m_sampleRate));
+  }
+  std::memcpy(output, m_data + m_position * m_itemSize, m_itemSize * count);
+  m_position += count;
+  m_produced += count;
+  return count;
+}
+
+bool FileSource::start() {
+  m_startTime = std::chrono::steady_clock::now();
+  m_produced = 0;
+  return true;
+}
+
+bool FileSource::setCenterFrequency(Frequency frequency) { return frequency == m_frequency; }
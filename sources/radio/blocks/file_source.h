@@ -0,0 +1,31 @@
+#pragma once
+
+#include <radio/blocks/source.h>
+#include <radio/help_structures.h>
+
+#include <chrono>
+
+class FileSource : public Source {
+ public:
+  FileSource(const Device& device);
+  ~FileSource();
+
+  int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+  bool start() override;
+  bool setCenterFrequency(Frequency frequency) override;
+
+ private:
+  const std::string m_path;
+  const bool m_realTime;
+  const bool m_loop;
+  Frequency m_frequency;
+  Frequency m_sampleRate;
+  int m_itemSize;
+  uint8_t* m_data;
+  size_t m_size;
+  size_t m_items;
+  size_t m_position;
+  uint64_t m_produced;
+  std::chrono::steady_clock::time_point m_startTime;
+};
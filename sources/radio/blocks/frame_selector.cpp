@@ -0,0 +1,122 @@
+#include "frame_selector.h"
+
+#include <logger.h>
+#include <metrics.h>
+#include <radio/blocks/source.h>
+#include <utils/radio_utils.h>
+
+#include <chrono>
+
+constexpr auto LABEL = "frame";
+
+FrameSelector::FrameSelector(const int itemSize, const int period, const int settle, const bool isBlocking, const SampleFormat format, const float scale, const std::string& deviceName)
+    : gr::block("FrameSelector", gr::io_signature::make(1, 1, getSampleSize(format)), gr::io_signature::make(1, 1, sizeof(gr_complex) * itemSize)),
+      m_itemSize(itemSize),
+      m_period(period),
+      m_settle(settle),
+      m_format(format),
+      m_scale(scale),
+      m_sampleSize(getSampleSize(format)),
+      m_retuneKey(pmt::string_to_symbol(RETUNE_TAG)),
+      m_discontinuityKey(pmt::string_to_symbol(DISCONTINUITY_TAG)),
+      m_latencyMetric(fmt::format("retune_latency_ms{{device=\"{}\"}}", deviceName)),
+      m_skip(0),
+      m_sequence(0),
+      m_retuneTime(0),
+      m_isDiscontinuity(false),
+      m_lost(0),
+      m_isBlocking(isBlocking),
+      m_requestTime(0),
+      m_requestSequence(0) {
+  set_relative_rate(1, m_period);
+  set_tag_propagation_policy(TPP_DONT);
+}
+
+void FrameSelector::forecast(int, gr_vector_int& ninput_items_required) { ninput_items_required[0] = 0 < m_skip || m_sequence < m_requestSequence ? 1 : m_itemSize; }
+
+int FrameSelector::general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
+  const uint8_t* in = static_cast<const uint8_t*>(input_items[0]);
+  gr_complex* out = static_cast<gr_complex*>(output_items[0]);
+  const auto size = ninput_items[0];
+
+  if (m_isBlocking) {
+    consume_each(size);
+    return 0;
+  }
+
+  int consumed = 0;
+  const auto start = nitems_read(0);
+  const auto requestSequence = m_requestSequence.load();
+  get_tags_in_range(m_tags, 0, start, start + size, m_retuneKey);
+  if (!m_tags.empty()) {
+    // everything before last retune belongs to previous frequency
+    consumed = static_cast<int>(m_tags.back().offset - start);
+    m_skip = m_settle;
+    m_isDiscontinuity = false;
+    m_lost = 0;
+    const auto sequence = pmt::to_uint64(m_tags.back().value);
+    if (m_sequence < requestSequence && requestSequence <= sequence) {
+      m_retuneTime = m_requestTime;
+    }
+    m_sequence = std::max(m_sequence, sequence);
+  }
+  if (m_sequence < requestSequence) {
+    consume_each(size);
+    return 0;
+  }
+
+  get_tags_in_range(m_discontinuityTags, 0, start + consumed, start + size, m_discontinuityKey);
+  auto tag = m_discontinuityTags.begin();
+  const auto passTags = [this, &tag](const uint64_t offset) {
+    for (; tag != m_discontinuityTags.end() && tag->offset <= offset; ++tag) {
+      m_isDiscontinuity = true;
+      m_lost += pmt::to_uint64(tag->value);
+    }
+  };
+
+  int produced = 0;
+  while (produced < noutput_items) {
+    const auto skipped = std::min(m_skip, size - consumed);
+    consumed += skipped;
+    m_skip -= skipped;
+    if (0 < m_skip || size - consumed < m_itemSize) {
+      break;
+    }
+    passTags(start + consumed);
+    if (tag != m_discontinuityTags.end() && tag->offset < start + consumed + m_itemSize) {
+      // frame would span lost samples, start it again at first sample after them
+      consumed = static_cast<int>(tag->offset - start);
+      continue;
+    }
+    toComplex(in + static_cast<size_t>(consumed) * m_sampleSize, out + produced * m_itemSize, m_itemSize, m_format, m_scale);
+    if (m_isDiscontinuity) {
+      add_item_tag(0, nitems_written(0) + produced, m_discontinuityKey, pmt::from_uint64(m_lost));
+      m_isDiscontinuity = false;
+      m_lost = 0;
+    }
+    consumed += m_itemSize;
+    produced++;
+    m_skip = m_period - m_itemSize;
+  }
+  if (0 < consumed) {
+    passTags(start + consumed - 1);
+  }
+
+  if (0 < produced && m_retuneTime) {
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    const auto latency = (now - m_retuneTime) / 1e6;
+    Metrics::observe(m_latencyMetric, latency);
+    LOG_TRACE(LABEL, "retune to valid data: {:.2f} ms", latency);
+    m_retuneTime = 0;
+  }
+
+  consume_each(consumed);
+  return produced;
+}
+
+void FrameSelector::setBlocking(bool isBlocking) { m_isBlocking = isBlocking; }
+
+void FrameSelector::waitForRetune(uint64_t sequence) {
+  m_requestTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  m_requestSequence = sequence;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <gnuradio/block.h>
+#include <radio/help_structures.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+// keeps first itemSize samples of every period, remaining samples are consumed without copying
+// after waitForRetune all samples are dropped until retune tag with same or newer sequence number, then settle window is dropped
+// frames never span lost samples, first frame after them is tagged with DISCONTINUITY_TAG
+// input is in source sample format, only kept frames are converted to float
+class FrameSelector : virtual public gr::block {
+ public:
+  FrameSelector(const int itemSize, const int period, const int settle, const bool isBlocking, const SampleFormat format, const float scale, const std::string& deviceName);
+
+  void forecast(int noutput_items, gr_vector_int& ninput_items_required) override;
+  int general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
+
+  void setBlocking(bool isBlocking);
+  void waitForRetune(uint64_t sequence);
+
+ private:
+  const int m_itemSize;
+  const int m_period;
+  const int m_settle;
+  const SampleFormat m_format;
+  const float m_scale;
+  const int m_sampleSize;
+  const pmt::pmt_t m_retuneKey;
+  const pmt::pmt_t m_discontinuityKey;
+  const std::string m_latencyMetric;
+  int m_skip;
+  uint64_t m_sequence;
+  int64_t m_retuneTime;
+  std::vector<gr::tag_t> m_tags;
+  std::vector<gr::tag_t> m_discontinuityTags;
+  bool m_isDiscontinuity;
+  uint64_t m_lost;
+  std::atomic<bool> m_isBlocking;
+  std::atomic<int64_t> m_requestTime;
+  std::atomic<uint64_t> m_requestSequence;
+};
@@ -2,36 +2,77 @@
 
 #include <config.h>
 #include <logger.h>
+#include <utils/simd_utils.h>
+#include <utils/thread_utils.h>
 #include <utils/utils.h>
 
+#include <algorithm>
+#include <cmath>
+
 constexpr auto LABEL = "noise";
+constexpr auto MAX_UPDATES = 1 << 24;
 
-NoiseLearner::Noise::Noise() : m_startLearningTime(getTime()), m_samples(0), m_isReady(false) {}
+NoiseLearner::Noise::Noise() : m_storeTime(0), m_updates(0), m_frames(0) {}
 
-bool NoiseLearner::Noise::add(const float* data, const int size) {
-  if (m_isReady) {
-    return true;
-  }
-  if (static_cast<int>(m_threshold.size()) < size) {
-    m_threshold.resize(size, -std::numeric_limits<float>::max());
-  }
-  const auto now = getTime();
-  for (int i = 0; i < size; ++i) {
-    m_threshold[i] = std::max(m_threshold[i], data[i]);
+void NoiseLearner::Noise::init(const float* data, const int size) {
+  // percentile across all bins of first frame is a good start for flat noise floor
+  m_floor.assign(data, data + size);
+  auto quantile = m_floor.begin() + static_cast<int>(size * NOISE_QUANTILE);
+  std::nth_element(m_floor.begin(), quantile, m_floor.end());
+  std::fill(m_floor.begin(), m_floor.end(), *quantile);
+  m_threshold.resize(size);
+}
+
+void NoiseLearner::Noise::load(const std::vector<float>& threshold) {
+  m_threshold = threshold;
+  m_floor.resize(threshold.size());
+  std::transform(threshold.begin(), threshold.end(), m_floor.begin(), [](const float value) { return value - NOISE_QUANTILE_MARGIN; });
+  m_updates = NOISE_CACHE_MIN_UPDATES;
+  m_storeTime = getTime();
+}
+
+bool NoiseLearner::Noise::update(const float* data, const int size) {
+  if (m_floor.empty()) {
+    init(data, size);
   }
-  m_samples++;
-  if (m_startLearningTime + NOISE_LEARNING_TIME <= now) {
-    m_isReady = true;
-    return true;
+  if (isReady() && m_frames++ % NOISE_TRACKING_DECIMATION != 0) {
+    return false;
   }
-  return false;
+  const auto step = std::max(NOISE_TRACKING_STEP, NOISE_TRACKING_INITIAL_STEP / std::sqrt(static_cast<float>(m_updates + 1)));
+  trackQuantile(m_floor.data(), data, size, step * NOISE_QUANTILE, step * (1.0f - NOISE_QUANTILE));
+  std::transform(m_floor.begin(), m_floor.end(), m_threshold.begin(), [](const float value) { return value + NOISE_QUANTILE_MARGIN; });
+  m_updates = std::min(m_updates + 1, MAX_UPDATES);
+  return true;
 }
 
-NoiseLearner::NoiseLearner(int itemSize, std::function<Frequency()> getFrequency, std::function<Frequency(const int index)> indexToFrequency)
+bool NoiseLearner::Noise::isReady() const { return NOISE_TRACKING_WARMUP <= m_updates; }
+
+NoiseLearner::NoiseLearner(
+    int itemSize, std::function<Frequency()> getFrequency, std::function<Frequency(const int index)> indexToFrequency, std::shared_ptr<NoiseCache> cache, const std::vector<int>& storeCores)
     : gr::sync_block("NoiseLearner", gr::io_signature::make(1, 1, sizeof(float) * itemSize), gr::io_signature::make(1, 1, sizeof(float) * itemSize)),
       m_itemSize(itemSize),
       m_getFrequency(getFrequency),
-      m_indexToFrequency(indexToFrequency) {}
+      m_indexToFrequency(indexToFrequency),
+      m_cache(cache),
+      m_isRunning(true) {
+  if (m_cache) {
+    m_storeThread = std::thread([this]() { storeWorker(); });
+    if (!setThreadAffinity(m_storeThread.native_handle(), storeCores)) {
+      Logger::warn(LABEL, "set thread affinity failed, cores: {}", colored(RED, "{}", formatCores(storeCores)));
+    }
+  }
+}
+
+NoiseLearner::~NoiseLearner() {
+  {
+    std::unique_lock<std::mutex> lock(m_storeMutex);
+    m_isRunning = false;
+    m_storeCv.notify_all();
+  }
+  if (m_storeThread.joinable()) {
+    m_storeThread.join();
+  }
+}
 
 int NoiseLearner::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
   const float* input_buf = static_cast<const float*>(input_items[0]);
@@ -39,16 +80,35 @@ int NoiseLearner::work(int noutput_items, gr_vector_const_void_star& input_items
 
   std::unique_lock<std::mutex> lock(m_mutex);
   const auto frequency = m_getFrequency();
+  const auto isNew = m_noise.count(frequency) == 0;
   auto& noise = m_noise[frequency];
+  if (isNew && m_cache) {
+    std::vector<float> threshold;
+    if (m_cache->load(frequency, threshold, getTime())) {
+      noise.load(threshold);
+      Logger::info(LABEL, "loaded from cache, frequency: {}", formatFrequency(frequency));
+    }
+  }
   for (int i = 0; i < noutput_items; ++i) {
     const auto fitIndex = i * m_itemSize;
-    if (!noise.m_isReady) {
-      if (noise.add(&input_buf[fitIndex], m_itemSize)) {
-        Logger::info(LABEL, "learning completed, frequency: {}", formatFrequency(frequency));
-      }
+    const auto wasReady = noise.isReady();
+    const auto isUpdated = noise.update(&input_buf[fitIndex], m_itemSize);
+    if (!noise.isReady()) {
       setNoData(&output_buf[fitIndex], m_itemSize);
       continue;
     }
+    if (!wasReady) {
+      Logger::info(LABEL, "learning completed, frequency: {}", formatFrequency(frequency));
+    }
+    if (m_cache && isUpdated && NOISE_CACHE_MIN_UPDATES <= noise.m_updates) {
+      const auto now = getTime();
+      if (noise.m_storeTime + NOISE_CACHE_STORE_INTERVAL <= now) {
+        std::unique_lock<std::mutex> storeLock(m_storeMutex);
+        m_stores[frequency] = {now, noise.m_threshold};
+        m_storeCv.notify_one();
+        noise.m_storeTime = now;
+      }
+    }
 
     int maxIndex = 0;
     for (int j = 0; j < m_itemSize; ++j) {
@@ -60,12 +120,27 @@ int NoiseLearner::work(int noutput_items, gr_vector_const_void_star& input_items
 
     const auto frequency = m_indexToFrequency(maxIndex);
     const auto maxValue = output_buf[fitIndex + maxIndex];
-    Logger::trace(LABEL, "best signal, frequency: {}, power: {}", formatFrequency(frequency), formatPower(maxValue));
+    LOG_TRACE(LABEL, "best signal, frequency: {}, power: {}", formatFrequency(frequency), formatPower(maxValue));
   }
 
   return noutput_items;
 }
 
+void NoiseLearner::storeWorker() {
+  std::unique_lock<std::mutex> lock(m_storeMutex);
+  while (true) {
+    m_storeCv.wait(lock, [this]() { return !m_isRunning || !m_stores.empty(); });
+    if (m_stores.empty()) {
+      // pending stores are written before stop
+      break;
+    }
+    auto node = m_stores.extract(m_stores.begin());
+    lock.unlock();
+    m_cache->store(node.key(), node.mapped().second, node.mapped().first);
+    lock.lock();
+  }
+}
+
 void NoiseLearner::resetBuffers() {
   std::unique_lock<std::mutex> lock(m_mutex);
   m_noise.clear();
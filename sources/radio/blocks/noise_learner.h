@@ -2,33 +2,54 @@
 
 #include <gnuradio/sync_block.h>
 #include <radio/help_structures.h>
+#include <radio/noise_cache.h>
 
+#include <condition_variable>
 #include <functional>
 #include <map>
+#include <memory>
+#include <thread>
 
 class NoiseLearner : virtual public gr::sync_block {
  private:
+  // low percentile of every bin tracked continuously, threshold is floor + NOISE_QUANTILE_MARGIN
   struct Noise {
     Noise();
 
+    std::vector<float> m_floor;
     std::vector<float> m_threshold;
-    std::chrono::milliseconds m_startLearningTime;
-    int m_samples;
-    bool m_isReady;
-
-    bool add(const float* data, const int size);
+    std::chrono::milliseconds m_storeTime;
+    int m_updates;
+    int m_frames;
+
+    void init(const float* data, const int size);
+    void load(const std::vector<float>& threshold);
+    bool update(const float* data, const int size);
+    bool isReady() const;
   };
 
  public:
-  NoiseLearner(const int itemSize, std::function<Frequency()> getFrequency, std::function<Frequency(const int index)> indexToFrequency);
+  NoiseLearner(
+      const int itemSize, std::function<Frequency()> getFrequency, std::function<Frequency(const int index)> indexToFrequency, std::shared_ptr<NoiseCache> cache, const std::vector<int>& storeCores);
+  ~NoiseLearner();
 
   int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
   void resetBuffers();
 
  private:
+  void storeWorker();
+
   const int m_itemSize;
   const std::function<Frequency()> m_getFrequency;
   const std::function<Frequency(const int index)> m_indexToFrequency;
+  const std::shared_ptr<NoiseCache> m_cache;
   std::mutex m_mutex;
   std::map<Frequency, Noise> m_noise;
-};
\ No newline at end of file
+
+  // thresholds waiting for store, written to cache file outside of detection thread
+  std::mutex m_storeMutex;
+  std::condition_variable m_storeCv;
+  std::map<Frequency, std::pair<std::chrono::milliseconds, std::vector<float>>> m_stores;
+  bool m_isRunning;
+  std::thread m_storeThread;
+};
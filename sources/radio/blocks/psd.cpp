@@ -1,12 +1,14 @@
 #include "psd.h"
 
+#include <utils/simd_utils.h>
+
 constexpr auto LABEL = "PSD";
 
-PSD::PSD(int itemSize, Frequency sample_rate)
+PSD::PSD(int itemSize, Frequency sample_rate, const std::string& deviceName)
     : gr::sync_block("PSD", gr::io_signature::make(1, 1, sizeof(gr_complex) * itemSize), gr::io_signature::make(1, 1, sizeof(float) * itemSize)),
-      m_performanceLogger(LABEL),
+      m_performanceLogger(LABEL, deviceName),
       m_itemSize(itemSize),
-      m_sampleRate(sample_rate) {}
+      m_offset(-10.0f * std::log10(static_cast<float>(sample_rate))) {}
 
 int PSD::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
   const gr_complex* input_buf = static_cast<const gr_complex*>(input_items[0]);
@@ -15,8 +17,6 @@ int PSD::work(int noutput_items, gr_vector_const_void_star& input_items, gr_vect
   for (int i = 0; i < noutput_items; ++i) {
     m_performanceLogger.kick();
   }
-  for (int i = 0; i < m_itemSize * noutput_items; ++i) {
-    output_buf[i] = 10.0f * std::log10(std::pow(std::abs(input_buf[i]), 2.0f) / m_sampleRate);
-  }
+  powerToDecibels(input_buf, output_buf, m_itemSize * noutput_items, m_offset);
   return noutput_items;
 }
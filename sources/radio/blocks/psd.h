@@ -6,12 +6,12 @@
 
 class PSD : virtual public gr::sync_block {
  public:
-  PSD(int itemSize, Frequency sample_rate);
+  PSD(int itemSize, Frequency sample_rate, const std::string& deviceName);
 
   int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
 
  private:
   PerformanceLogger m_performanceLogger;
   const int m_itemSize;
-  const Frequency m_sampleRate;
+  const float m_offset;
 };
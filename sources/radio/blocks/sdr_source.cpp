@@ -2,15 +2,50 @@
 
 #include <SoapySDR/Formats.h>
 #include <logger.h>
+#include <metrics.h>
+#include <utils/radio_utils.h>
+#include <utils/thread_utils.h>
 #include <utils/utils.h>
 
 #include <SoapySDR/Errors.hpp>
 
 constexpr auto LABEL = "source";
 
+namespace {
+const char* getSoapyFormat(const SampleFormat format) {
+  switch (format) {
+    case SampleFormat::CS16:
+      return SOAPY_SDR_CS16;
+    case SampleFormat::CS8:
+      return SOAPY_SDR_CS8;
+    default:
+      return SOAPY_SDR_CF32;
+  }
+}
+}  // namespace
+
 SdrSource::SdrSource(const Device& device)
-    : gr::sync_block("SdrSource", gr::io_signature::make(0, 0, 0), gr::io_signature::make(1, 1, sizeof(gr_complex))), m_configDevice(device), m_device(nullptr), m_stream(nullptr) {
+    : gr::sync_block("SdrSource", gr::io_signature::make(0, 0, 0), gr::io_signature::make(1, 1, getSampleSize(device.m_sampleFormat))),
+      Source(device.m_sampleFormat),
+      m_configDevice(device),
+      m_device(nullptr),
+      m_stream(nullptr),
+      m_isPrioritySet(false),
+      m_isDiscontinuity(false),
+      m_nextTime(0),
+      m_samples(0),
+      m_overflows(0),
+      m_timeouts(0),
+      m_lost(0),
+      m_samplesMetric(fmt::format("samples_read_total{{device=\"{}\"}}", device.getName())),
+      m_overflowsMetric(fmt::format("overflows_total{{device=\"{}\"}}", device.getName())),
+      m_timeoutsMetric(fmt::format("timeouts_total{{device=\"{}\"}}", device.getName())),
+      m_lostMetric(fmt::format("lost_samples_total{{device=\"{}\"}}", device.getName())) {
   m_device = SoapySDR::Device::make(fmt::format("driver={},serial={}", device.m_driver, device.m_serial));
+  {
+    std::unique_lock<std::mutex> lock(_openedMutex);
+    _opened.insert(device.getName());
+  }
   m_device->setGainMode(SOAPY_SDR_RX, 0, false);
   for (const auto& [key, value] : device.m_gains) {
     Logger::info(LABEL, "set gain, key: {}, value: {}", colored(GREEN, "{}", key), colored(GREEN, "{}", value));
@@ -18,11 +53,31 @@ SdrSource::SdrSource(const Device& device)
   }
   Logger::info(LABEL, "sample rate: {}", formatFrequency(device.m_sampleRate));
   m_device->setSampleRate(SOAPY_SDR_RX, 0, device.m_sampleRate);
+
+  // native integer samples may use less bits than container, scale them same way driver does for cf32
+  double fullScale = 0.0;
+  const auto nativeFormat = m_device->getNativeStreamFormat(SOAPY_SDR_RX, 0, fullScale);
+  if (device.m_sampleFormat != SampleFormat::CF32 && nativeFormat == getSoapyFormat(device.m_sampleFormat) && 0.0 < fullScale) {
+    setSampleScale(static_cast<float>(1.0 / fullScale));
+  }
+  Logger::info(
+      LABEL,
+      "sample format: {}, native format: {}, full scale: {}",
+      colored(GREEN, "{}", getSampleFormatName(device.m_sampleFormat)),
+      colored(GREEN, "{}", nativeFormat),
+      colored(GREEN, "{}", fullScale));
 }
 
 SdrSource::~SdrSource() {
   stop();
   SoapySDR::Device::unmake(m_device);
+  std::unique_lock<std::mutex> lock(_openedMutex);
+  _opened.erase(m_configDevice.getName());
+}
+
+bool SdrSource::isOpened(const std::string& driver, const std::string& serial) {
+  std::unique_lock<std::mutex> lock(_openedMutex);
+  return _opened.count(driver + "_" + serial) != 0;
 }
 
 int SdrSource::work(int noutput_items, gr_vector_const_void_star&, gr_vector_void_star& output_items) {
@@ -30,16 +85,53 @@ int SdrSource::work(int noutput_items, gr_vector_const_void_star&, gr_vector_voi
   long long int time_ns = 0;
   const long timeout_us = 500000;  // 0.5 sec
 
+  if (!m_isPrioritySet) {
+    // work is always called from block thread, gnuradio keeps SCHED_OTHER when setting its own priority
+    m_isPrioritySet = true;
+    if (0 < m_configDevice.m_sourcePriority && !setThreadRealTimePriority(pthread_self(), m_configDevice.m_sourcePriority)) {
+      Logger::warn(LABEL, "set real time priority failed, priority: {}", colored(RED, "{}", m_configDevice.m_sourcePriority));
+    }
+  }
+
   std::lock_guard<std::mutex> lock(m_mutex);
+  addRetuneTag();
   const auto result = m_device->readStream(m_stream, output_items.data(), noutput_items, flags, time_ns, timeout_us);
-  if (0 <= result) {
-    return result;
-  } else {
+  if (result == SOAPY_SDR_OVERFLOW) {
+    // driver dropped samples, lost count is known only if next read has timestamp
+    m_overflows++;
+    Metrics::increment(m_overflowsMetric);
+    LOG_DEBUG(LABEL, "overflow");
+    m_isDiscontinuity = true;
+    return 0;
+  } else if (result == SOAPY_SDR_TIMEOUT) {
+    m_timeouts++;
+    Metrics::increment(m_timeoutsMetric);
+    LOG_DEBUG(LABEL, "timeout");
+    m_isDiscontinuity = true;
+    return 0;
+  } else if (result < 0) {
     Logger::error(LABEL, "soapy error: {}", SoapySDR::errToStr(result));
     Logger::flush();
     exit(1);
     return 0;
   }
+
+  uint64_t lost = 0;
+  if (flags & SOAPY_SDR_HAS_TIME) {
+    if (m_nextTime) {
+      lost = std::max<int64_t>(0, std::llround((time_ns - m_nextTime) * 1e-9 * m_configDevice.m_sampleRate));
+    }
+    m_nextTime = time_ns + static_cast<int64_t>(result * 1e9 / m_configDevice.m_sampleRate);
+  }
+  if (m_isDiscontinuity || 0 < lost || (flags & SOAPY_SDR_END_ABRUPT)) {
+    m_lost += lost;
+    Metrics::increment(m_lostMetric, lost);
+    addDiscontinuityTag(lost);
+    m_isDiscontinuity = false;
+  }
+  m_samples += result;
+  Metrics::increment(m_samplesMetric, result);
+  return result;
 }
 
 int SdrSource::general_work(int noutput_items, gr_vector_int&, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) {
@@ -49,9 +141,10 @@ int SdrSource::general_work(int noutput_items, gr_vector_int&, gr_vector_const_v
 
 bool SdrSource::start() {
   std::lock_guard<std::mutex> lock(m_mutex);
-  m_stream = m_device->setupStream(SOAPY_SDR_RX, SOAPY_SDR_CF32);
+  m_stream = m_device->setupStream(SOAPY_SDR_RX, getSoapyFormat(m_configDevice.m_sampleFormat));
   set_max_noutput_items(std::max(static_cast<size_t>(1024), m_device->getStreamMTU(m_stream)));
   m_device->activateStream(m_stream);
+  m_nextTime = 0;
   return true;
 }
 
@@ -61,6 +154,13 @@ bool SdrSource::stop() {
     m_device->deactivateStream(m_stream);
     m_device->closeStream(m_stream);
     m_stream = nullptr;
+    Logger::info(
+        LABEL,
+        "samples: {}, overflows: {}, timeouts: {}, lost samples: {}",
+        colored(GREEN, "{}", m_samples),
+        colored(0 < m_overflows ? RED : GREEN, "{}", m_overflows),
+        colored(0 < m_timeouts ? RED : GREEN, "{}", m_timeouts),
+        colored(0 < m_lost ? RED : GREEN, "{}", m_lost));
   }
   return true;
 }
@@ -72,9 +172,10 @@ void SdrSource::resetBuffers() {
   } else {
     m_device->deactivateStream(m_stream);
     m_device->closeStream(m_stream);
-    m_stream = m_device->setupStream(SOAPY_SDR_RX, SOAPY_SDR_CF32);
+    m_stream = m_device->setupStream(SOAPY_SDR_RX, getSoapyFormat(m_configDevice.m_sampleFormat));
     m_device->activateStream(m_stream);
   }
+  m_nextTime = 0;
 }
 
 bool SdrSource::setCenterFrequency(Frequency frequency) {
@@ -1,12 +1,14 @@
 #pragma once
 
-#include <gnuradio/sync_block.h>
+#include <radio/blocks/source.h>
 #include <radio/help_structures.h>
 
 #include <SoapySDR/Device.hpp>
 #include <mutex>
+#include <set>
+#include <string>
 
-class SdrSource : virtual public gr::sync_block {
+class SdrSource : public Source {
  public:
   SdrSource(const Device& device);
   ~SdrSource();
@@ -18,11 +20,28 @@ class SdrSource : virtual public gr::sync_block {
   bool stop() override;
 
   void resetBuffers();
-  bool setCenterFrequency(Frequency frequency);
+  bool setCenterFrequency(Frequency frequency) override;
+
+  // device held by running source must not be opened again, e.g. to probe it
+  static bool isOpened(const std::string& driver, const std::string& serial);
 
  private:
+  inline static std::mutex _openedMutex;
+  inline static std::set<std::string> _opened;
+
   const Device m_configDevice;
   std::mutex m_mutex;
   SoapySDR::Device* m_device;
   SoapySDR::Stream* m_stream;
+  bool m_isPrioritySet;
+  bool m_isDiscontinuity;
+  int64_t m_nextTime;
+  uint64_t m_samples;
+  uint64_t m_overflows;
+  uint64_t m_timeouts;
+  uint64_t m_lost;
+  const std::string m_samplesMetric;
+  const std::string m_overflowsMetric;
+  const std::string m_timeoutsMetric;
+  const std::string m_lostMetric;
 };
\ No newline at end of file
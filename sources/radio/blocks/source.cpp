@@ -0,0 +1,28 @@
+#include "source.h"
+
+#include <utils/radio_utils.h>
+
+Source::Source(const SampleFormat format) : m_sampleFormat(format), m_sampleScale(::getSampleScale(format)), m_retuneSequence(0), m_taggedSequence(0) {}
+
+bool Source::retune(Frequency frequency, uint64_t sequence) {
+  const auto isTuned = setCenterFrequency(frequency);
+  // set after tuning, so tag never lands on sample read before new frequency was applied
+  m_retuneSequence = sequence;
+  return isTuned;
+}
+
+void Source::addRetuneTag() {
+  const auto sequence = m_retuneSequence.load();
+  if (sequence != m_taggedSequence) {
+    add_item_tag(0, nitems_written(0), pmt::string_to_symbol(RETUNE_TAG), pmt::from_uint64(sequence));
+    m_taggedSequence = sequence;
+  }
+}
+
+void Source::addDiscontinuityTag(const uint64_t lost) { add_item_tag(0, nitems_written(0), pmt::string_to_symbol(DISCONTINUITY_TAG), pmt::from_uint64(lost)); }
+
+SampleFormat Source::getSampleFormat() const { return m_sampleFormat; }
+
+float Source::getSampleScale() const { return m_sampleScale; }
+
+void Source::setSampleScale(const float scale) { m_sampleScale = scale; }
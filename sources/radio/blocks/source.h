@@ -0,0 +1,35 @@
+#pragma once
+
+#include <gnuradio/sync_block.h>
+#include <radio/help_structures.h>
+
+#include <atomic>
+
+constexpr auto RETUNE_TAG = "retune";
+constexpr auto DISCONTINUITY_TAG = "discontinuity";
+
+// first sample read after retune is tagged with RETUNE_TAG, tag value is retune sequence number
+// retunes requested faster than samples are read share one tag with the last sequence number
+// first sample read after lost samples is tagged with DISCONTINUITY_TAG, tag value is lost samples count or 0 if unknown
+// samples are produced in native format, consumers convert to float with sample scale only where needed
+class Source : virtual public gr::sync_block {
+ public:
+  Source(const SampleFormat format);
+
+  bool retune(Frequency frequency, uint64_t sequence);
+  virtual bool setCenterFrequency(Frequency frequency) = 0;
+
+  SampleFormat getSampleFormat() const;
+  float getSampleScale() const;
+
+ protected:
+  void addRetuneTag();
+  void addDiscontinuityTag(const uint64_t lost);
+  void setSampleScale(const float scale);
+
+ private:
+  const SampleFormat m_sampleFormat;
+  float m_sampleScale;
+  std::atomic<uint64_t> m_retuneSequence;
+  uint64_t m_taggedSequence;
+};
@@ -8,6 +8,8 @@ constexpr auto LABEL = "spectogram";
 
 Spectrogram::Container::Container(int size) : m_lastDataSendTime(getTime()) { m_sum.resize(size); }
 
+Spectrogram::Live::Live() : m_fps(0), m_bins(0), m_frequency(0), m_counter(0), m_lastDataSendTime(0) {}
+
 Spectrogram::Spectrogram(const int itemSize, const Frequency sampleRate, DataController& dataController, std::function<Frequency()> getFrequency)
     : gr::sync_block("Spectrogram", gr::io_signature::make(1, 1, sizeof(float) * itemSize), gr::io_signature::make(0, 0, 0)),
       m_inputSize(itemSize),
@@ -37,6 +39,7 @@ int Spectrogram::work(int noutput_items, gr_vector_const_void_star& input_items,
     }
     process(it->second, &in[i * m_inputSize]);
     send(it->second);
+    processLive(&in[i * m_inputSize], frequency);
   }
 
   return noutput_items;
@@ -73,3 +76,54 @@ void Spectrogram::send(Container& container) {
     container.m_lastDataSendTime = now;
   }
 }
+
+void Spectrogram::processLive(const float* data, const Frequency frequency) {
+  const auto now = getTime();
+  const auto request = m_dataController.getLiveRequest(now);
+  if (!request) {
+    if (m_live.m_encoder) {
+      Logger::info(LABEL, "live stopped");
+      m_live.m_encoder.reset();
+    }
+    return;
+  }
+
+  const auto bins = std::min(request->m_bins, m_inputSize);
+  if (!m_live.m_encoder || m_live.m_fps != request->m_fps || m_live.m_bins != bins) {
+    const auto keyframeInterval = std::max(1, static_cast<int>(request->m_fps * LIVE_SPECTROGRAM_KEYFRAME_INTERVAL.count() / 1000));
+    Logger::info(LABEL, "live started, fps: {}, bins: {}", colored(GREEN, "{}", request->m_fps), colored(GREEN, "{}", bins));
+    m_live.m_fps = request->m_fps;
+    m_live.m_bins = bins;
+    m_live.m_sum.assign(bins, 0.0f);
+    m_live.m_row.resize(bins);
+    m_live.m_counter = 0;
+    m_live.m_lastDataSendTime = now;
+    m_live.m_encoder = std::make_unique<WaterfallEncoder>(bins, keyframeInterval);
+  }
+  if (m_live.m_frequency != frequency) {
+    m_live.m_frequency = frequency;
+    std::fill(m_live.m_sum.begin(), m_live.m_sum.end(), 0.0f);
+    m_live.m_counter = 0;
+    m_live.m_encoder->reset();
+  }
+
+  const auto decimatorFactor = m_inputSize / bins;
+  for (int i = 0; i < bins; ++i) {
+    float sum = 0.0;
+    for (int j = 0; j < decimatorFactor; ++j) {
+      sum += data[i * decimatorFactor + j];
+    }
+    m_live.m_sum[i] += sum / decimatorFactor;
+  }
+  m_live.m_counter++;
+
+  if (m_live.m_lastDataSendTime + std::chrono::milliseconds(1000 / m_live.m_fps) <= now) {
+    for (int i = 0; i < bins; ++i) {
+      m_live.m_row[i] = m_live.m_sum[i] / m_live.m_counter;
+    }
+    m_dataController.pushLiveSpectrogram(now, frequency, m_sampleRate, m_live.m_encoder->encode(m_live.m_row.data()), bins);
+    std::fill(m_live.m_sum.begin(), m_live.m_sum.end(), 0.0f);
+    m_live.m_counter = 0;
+    m_live.m_lastDataSendTime = now;
+  }
+}
@@ -2,8 +2,10 @@
 
 #include <gnuradio/sync_block.h>
 #include <network/data_controller.h>
+#include <utils/waterfall_codec.h>
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 class Spectrogram : virtual public gr::sync_block {
@@ -15,6 +17,19 @@ class Spectrogram : virtual public gr::sync_block {
     std::chrono::milliseconds m_lastDataSendTime;
   };
 
+  struct Live {
+    Live();
+
+    int m_fps;
+    int m_bins;
+    Frequency m_frequency;
+    std::vector<float> m_sum;
+    std::vector<int8_t> m_row;
+    int m_counter;
+    std::chrono::milliseconds m_lastDataSendTime;
+    std::unique_ptr<WaterfallEncoder> m_encoder;
+  };
+
  public:
   Spectrogram(const int itemSize, const Frequency sampleRate, DataController& dataController, std::function<Frequency()> getFrequency);
 
@@ -23,6 +38,7 @@ class Spectrogram : virtual public gr::sync_block {
  private:
   void process(Container& container, const float* data);
   void send(Container& container);
+  void processLive(const float* data, const Frequency frequency);
 
   const int m_inputSize;
   const int m_outputSize;
@@ -31,4 +47,5 @@ class Spectrogram : virtual public gr::sync_block {
   DataController& m_dataController;
   std::function<Frequency()> m_getFrequency;
   std::map<Frequency, Container> m_containers;
+  Live m_live;
 };
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include <config.h>
 #include <logger.h>
+#include <metrics.h>
+#include <radio/blocks/source.h>
+#include <utils/simd_utils.h>
 #include <utils/utils.h>
 
 constexpr auto LABEL = "transmission";
@@ -9,22 +12,27 @@ constexpr auto LABEL = "transmission";
 Transmission::Transmission(
     const Config& config,
     const Device& device,
+    const Snapshot<ScanSettings>& settings,
     const int itemSize,
     const int groupSize,
-    TransmissionNotification& notification,
-    std::function<Frequency(const Index index)> indexToFrequency,
-    std::function<Frequency(const Index index)> indexToShift,
-    std::function<bool(const int Index)> isIndexInRange)
+    const Frequency sampleRate,
+    TransmissionNotification& notification)
     : gr::sync_block("Transmission", gr::io_signature::make(1, 1, sizeof(float) * itemSize), gr::io_signature::make(0, 0, 0)),
       m_config(config),
-      m_device(device),
+      m_settings(settings),
+      m_scanSettings(settings.load()),
       m_itemSize(itemSize),
       m_groupSize(groupSize),
+      m_sampleRate(sampleRate),
       m_averager(itemSize, GROUPING_Y),
       m_notification(notification),
-      m_indexToFrequency(indexToFrequency),
-      m_indexToShift(indexToShift),
-      m_isIndexInRange(isIndexInRange) {
+      m_frequencyRange({0, 0}),
+      m_binTable(nullptr),
+      m_avgPower(itemSize),
+      m_indexes(itemSize),
+      m_discontinuityKey(pmt::string_to_symbol(DISCONTINUITY_TAG)),
+      m_performanceLogger(LABEL, device.getName()),
+      m_signalsMetric(fmt::format("signals_tracked{{device=\"{}\"}}", device.getName())) {
   Logger::info(LABEL, "group size: {}", colored(GREEN, "{}", m_groupSize));
 }
 
@@ -32,7 +40,16 @@ int Transmission::work(int noutput_items, gr_vector_const_void_star& input_items
   const float* input_buf = static_cast<const float*>(input_items[0]);
 
   std::unique_lock<std::mutex> lock(m_mutex);
+  applySettings();
+  const auto start = nitems_read(0);
+  get_tags_in_range(m_tags, 0, start, start + noutput_items, m_discontinuityKey);
+  auto tag = m_tags.begin();
   for (int i = 0; i < noutput_items; ++i) {
+    for (; tag != m_tags.end() && tag->offset == start + i; ++tag) {
+      // averaged frames would mix data from both sides of lost samples, tracked signals are kept
+      LOG_DEBUG(LABEL, "discontinuity, lost samples: {}", pmt::to_uint64(tag->value));
+      m_averager.reset();
+    }
     process(&input_buf[i * m_itemSize]);
   }
 
@@ -42,28 +59,64 @@ int Transmission::work(int noutput_items, gr_vector_const_void_star& input_items
 void Transmission::resetBuffers() {
   std::unique_lock<std::mutex> lock(m_mutex);
   for (const auto& [index, signal] : m_signals) {
-    const auto bestTunedFrequency = getTunedFrequency(m_indexToFrequency(index), m_config.recordingTuningStep());
+    const auto bestTunedFrequency = getTunedFrequency(m_binTable->frequency(index), m_config.recordingTuningStep());
     Logger::info(
         LABEL,
         "signal: {}, stop: {}, center: {}",
-        formatFrequency(m_indexToFrequency(index), BROWN),
+        formatFrequency(m_binTable->frequency(index), BROWN),
         formatFrequency(bestTunedFrequency, CYAN),
-        formatFrequency(m_indexToFrequency(signal.getIndex()), MAGENTA));
+        formatFrequency(m_binTable->frequency(signal.getIndex()), MAGENTA));
   }
   m_signals.clear();
   m_averager.reset();
 }
 
+void Transmission::setFrequencyRange(const FrequencyRange& frequencyRange) {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_frequencyRange = frequencyRange;
+  updateBinTable();
+}
+
+void Transmission::applySettings() {
+  const auto settings = m_settings.load();
+  if (settings == m_scanSettings) {
+    return;
+  }
+  const auto isIgnoredRangesChanged = settings->m_ignoredRanges != m_scanSettings->m_ignoredRanges;
+  m_scanSettings = settings;
+  if (isIgnoredRangesChanged) {
+    Logger::info(LABEL, "ignored ranges changed: {}", colored(GREEN, "{}", m_scanSettings->m_ignoredRanges.size()));
+    m_binTables.clear();
+    m_binTable = nullptr;
+    updateBinTable();
+  }
+}
+
+void Transmission::updateBinTable() {
+  if (m_frequencyRange.first == m_frequencyRange.second) {
+    return;
+  }
+  auto it = m_binTables.find(m_frequencyRange);
+  if (it == m_binTables.end()) {
+    it = m_binTables.try_emplace(m_frequencyRange, m_itemSize, m_sampleRate, m_frequencyRange, m_scanSettings->m_ignoredRanges).first;
+  }
+  m_binTable = &it->second;
+}
+
 void Transmission::process(const float* power) {
+  if (!m_binTable) {
+    return;
+  }
+  m_performanceLogger.kick();
   m_averager.push(power);
-  const auto bufferPower = m_averager.average();
-  std::vector<float> avgPower(bufferPower.size(), 0.0);
-  average(bufferPower.data(), avgPower.data(), bufferPower.size(), GROUPING_X);
+  const auto& bufferPower = m_averager.average();
+  average(bufferPower.data(), m_avgPower.data(), bufferPower.size(), GROUPING_X);
 
   const auto now = getTime();
-  addSignals(avgPower.data(), power, now);
-  updateSignals(avgPower.data(), power, now);
-  clearSignals(avgPower.data(), power, now);
+  addSignals(m_avgPower.data(), power, now);
+  updateSignals(m_avgPower.data(), power, now);
+  clearSignals(m_avgPower.data(), power, now);
+  Metrics::set(m_signalsMetric, m_signals.size());
   m_notification.notify(getSortedTransmissions(now));
 }
 
@@ -71,13 +124,13 @@ void Transmission::clearSignals(const float*, const float*, const std::chrono::m
   for (auto it = m_signals.begin(); it != m_signals.cend();) {
     const auto& [index, signal] = *it;
     if (signal.isTimeout(now) || signal.isMaximalTime(now)) {
-      const auto bestTunedFrequency = getTunedFrequency(m_indexToFrequency(index), m_config.recordingTuningStep());
+      const auto bestTunedFrequency = getTunedFrequency(m_binTable->frequency(index), m_config.recordingTuningStep());
       Logger::info(
           LABEL,
           "signal: {}, stop: {}, center: {}",
-          formatFrequency(m_indexToFrequency(index), BROWN),
+          formatFrequency(m_binTable->frequency(index), BROWN),
           formatFrequency(bestTunedFrequency, CYAN),
-          formatFrequency(m_indexToFrequency(signal.getIndex()), MAGENTA));
+          formatFrequency(m_binTable->frequency(signal.getIndex()), MAGENTA));
       m_signals.erase(it++);
     } else {
       it++;
@@ -86,26 +139,22 @@ void Transmission::clearSignals(const float*, const float*, const std::chrono::m
 }
 
 void Transmission::addSignals(const float* avgPower, const float* rawPower, const std::chrono::milliseconds now) {
-  std::vector<Index> indexes;
-  for (int i = 0; i < m_itemSize; ++i) {
-    if (m_device.m_startLevel <= avgPower[i] && m_isIndexInRange(i) && !isIndexIgnored(i)) {
-      indexes.push_back(i);
-    }
-  }
-  std::sort(indexes.begin(), indexes.end(), [avgPower](const Index& i1, const Index& i2) { return avgPower[i1] > avgPower[i2]; });
+  const auto count = getIndexesAboveThreshold(avgPower, m_binTable->mask(), m_itemSize, m_scanSettings->m_startLevel, m_indexes.data());
+  std::sort(m_indexes.begin(), m_indexes.begin() + count, [avgPower](const Index& i1, const Index& i2) { return avgPower[i1] > avgPower[i2]; });
 
-  for (const auto& index : indexes) {
+  for (int i = 0; i < count; ++i) {
+    const auto index = m_indexes[i];
     if (!containsWithMargin(m_signals, index, m_groupSize)) {
       const auto bestIndex = getBestIndex(index);
-      const auto bestTunedFrequency = getTunedFrequency(m_indexToFrequency(bestIndex), m_config.recordingTuningStep());
+      const auto bestTunedFrequency = getTunedFrequency(m_binTable->frequency(bestIndex), m_config.recordingTuningStep());
       Logger::info(
           LABEL,
           "signal: {}, start: {}, avg power: {}, raw power: {}",
-          formatFrequency(m_indexToFrequency(bestIndex), BROWN),
+          formatFrequency(m_binTable->frequency(bestIndex), BROWN),
           formatFrequency(bestTunedFrequency, CYAN),
           formatPower(avgPower[bestIndex], BROWN),
           formatPower(rawPower[bestIndex], BROWN));
-      m_signals.insert({bestIndex, {m_config, m_device, m_indexToFrequency, m_indexToShift, now}});
+      m_signals.insert({bestIndex, {m_config, now}});
     }
   }
 }
@@ -114,14 +163,14 @@ void Transmission::updateSignals(const float* avgPower, const float* rawPower, c
   for (auto& [index, signal] : m_signals) {
     const auto bestAvgIndex = getMaxIndex(avgPower, m_itemSize, index, m_groupSize);
     const auto bestRawIndex = getMaxIndex(rawPower, m_itemSize, index, m_groupSize);
-    signal.newData(bestAvgIndex, avgPower[bestAvgIndex], bestRawIndex, rawPower[bestRawIndex], now);
-    Logger::debug(
+    signal.newData(bestAvgIndex, avgPower[bestAvgIndex], bestRawIndex, rawPower[bestRawIndex], *m_scanSettings, now);
+    LOG_DEBUG(
         LABEL,
         "signal: {}, best avg: {}, {}, best raw: {}, {}, d: {:5d} ms, ld: {:5d} ms ago, fl: {}",
-        formatFrequency(m_indexToFrequency(index), BROWN),
-        formatFrequency(m_indexToFrequency(bestAvgIndex), CYAN),
+        formatFrequency(m_binTable->frequency(index), BROWN),
+        formatFrequency(m_binTable->frequency(bestAvgIndex), CYAN),
         formatPower(avgPower[bestAvgIndex], CYAN),
-        formatFrequency(m_indexToFrequency(bestRawIndex), MAGENTA),
+        formatFrequency(m_binTable->frequency(bestRawIndex), MAGENTA),
         formatPower(rawPower[bestRawIndex], MAGENTA),
         signal.getDuration().count(),
         signal.getLastDataTime(now).count(),
@@ -131,45 +180,35 @@ void Transmission::updateSignals(const float* avgPower, const float* rawPower, c
 
 Transmission::Index Transmission::getBestIndex(Index index) const {
   std::vector<Transmission::Index> buffer;
-  const auto min = m_averager.data().size() / 2;
-  const auto max = m_averager.data().size();
-  for (size_t i = min; i < max; ++i) {
-    const auto& row = m_averager.data().at(i);
-    const auto bestIndex = getMaxIndex(row.data(), row.size(), index, m_groupSize);
-    if (m_device.m_startLevel <= row[bestIndex]) {
+  const auto min = m_averager.rows() / 2;
+  const auto max = m_averager.rows();
+  for (int i = min; i < max; ++i) {
+    const auto row = m_averager.row(i);
+    const auto bestIndex = getMaxIndex(row, m_itemSize, index, m_groupSize);
+    if (m_scanSettings->m_startLevel <= row[bestIndex]) {
       const int timestamp = max - i - 1;
-      Logger::debug(
+      LOG_DEBUG(
           LABEL,
           "signal: {}, time: {}, best: {}, raw: {}",
-          formatFrequency(m_indexToFrequency(index), BROWN),
+          formatFrequency(m_binTable->frequency(index), BROWN),
           -timestamp,
-          formatFrequency(m_indexToFrequency(bestIndex), MAGENTA),
+          formatFrequency(m_binTable->frequency(bestIndex), MAGENTA),
           formatPower(row[bestIndex], MAGENTA));
       buffer.push_back(bestIndex);
     }
   }
   const auto mostFrequentIndex = mostFrequentValue(buffer);
-  Logger::debug(LABEL, "signal: {}, best: {}", formatFrequency(m_indexToFrequency(index), BROWN), formatFrequency(m_indexToFrequency(mostFrequentIndex), CYAN));
+  LOG_DEBUG(LABEL, "signal: {}, best: {}", formatFrequency(m_binTable->frequency(index), BROWN), formatFrequency(m_binTable->frequency(mostFrequentIndex), CYAN));
   return mostFrequentIndex;
 }
 
-bool Transmission::isIndexIgnored(const Index& index) const {
-  const auto frequency = m_indexToFrequency(index);
-  for (const auto& range : m_config.ignoredRanges()) {
-    if (range.first <= frequency && frequency <= range.second) {
-      return true;
-    }
-  }
-  return false;
-}
-
 std::vector<FrequencyFlush> Transmission::getSortedTransmissions(const std::chrono::milliseconds now) const {
   std::vector<Index> indexes;
   std::transform(m_signals.begin(), m_signals.end(), std::back_inserter(indexes), [](auto& kv) { return kv.first; });
   std::sort(indexes.begin(), indexes.end(), [this](const Index& i1, const Index& i2) { return m_signals.at(i1).getPower() > m_signals.at(i2).getPower(); });
   std::vector<FrequencyFlush> transmissions;
   for (const auto& index : indexes) {
-    const auto frequency = getTunedFrequency(m_indexToShift(index), m_config.recordingTuningStep());
+    const auto frequency = getTunedFrequency(m_binTable->shift(index), m_config.recordingTuningStep());
     transmissions.emplace_back(frequency, m_signals.at(index).needFlush(now));
   }
   return transmissions;
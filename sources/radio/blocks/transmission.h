@@ -2,13 +2,17 @@
 
 #include <config.h>
 #include <gnuradio/sync_block.h>
+#include <performance_logger.h>
 #include <radio/averager.h>
+#include <radio/bin_table.h>
 #include <radio/help_structures.h>
 #include <radio/signal.h>
+#include <utils/snapshot.h>
 
 #include <atomic>
+#include <map>
+#include <memory>
 #include <mutex>
-#include <set>
 
 class Transmission : virtual public gr::sync_block {
   using Index = int;
@@ -17,34 +21,43 @@ class Transmission : virtual public gr::sync_block {
   Transmission(
       const Config& config,
       const Device& device,
+      const Snapshot<ScanSettings>& settings,
       const int itemSize,
       const int groupSize,
-      TransmissionNotification& notification,
-      std::function<Frequency(const int index)> indexToFrequency,
-      std::function<Frequency(const int index)> indexToShift,
-      std::function<bool(const int Index)> isIndexInRange);
+      const Frequency sampleRate,
+      TransmissionNotification& notification);
 
   int work(int noutput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override;
   void resetBuffers();
+  void setFrequencyRange(const FrequencyRange& frequencyRange);
 
  private:
+  void applySettings();
+  void updateBinTable();
   void process(const float* power);
   void clearSignals(const float* avgPower, const float* rawPower, const std::chrono::milliseconds now);
   void addSignals(const float* avgPower, const float* rawPower, const std::chrono::milliseconds now);
   void updateSignals(const float* avgPower, const float* rawPower, const std::chrono::milliseconds now);
   Index getBestIndex(Index index) const;
-  bool isIndexIgnored(const Index& index) const;
   std::vector<FrequencyFlush> getSortedTransmissions(const std::chrono::milliseconds now) const;
 
   const Config& m_config;
-  const Device& m_device;
+  const Snapshot<ScanSettings>& m_settings;
+  std::shared_ptr<const ScanSettings> m_scanSettings;
   const int m_itemSize;
   const int m_groupSize;
+  const Frequency m_sampleRate;
   Averager m_averager;
   TransmissionNotification& m_notification;
-  const std::function<Frequency(const Index index)> m_indexToFrequency;
-  const std::function<Frequency(const Index index)> m_indexToShift;
-  const std::function<bool(const Index index)> m_isIndexInRange;
   std::mutex m_mutex;
+  std::map<FrequencyRange, BinTable> m_binTables;
+  FrequencyRange m_frequencyRange;
+  const BinTable* m_binTable;
+  std::vector<float> m_avgPower;
+  std::vector<Index> m_indexes;
   std::map<Index, Signal> m_signals;
+  const pmt::pmt_t m_discontinuityKey;
+  std::vector<gr::tag_t> m_tags;
+  PerformanceLogger m_performanceLogger;
+  const std::string m_signalsMetric;
 };
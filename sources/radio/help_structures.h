@@ -16,6 +16,8 @@ using FrequencyFlush = std::pair<Frequency, bool>;
 using TransmissionNotification = Notification<std::vector<FrequencyFlush>>;
 using SimpleComplex = std::complex<int8_t>;
 
+enum class SampleFormat { CF32, CS16, CS8 };
+
 struct Device {
   bool m_enabled{};
   std::vector<std::pair<std::string, float>> m_gains{};
@@ -25,6 +27,22 @@ struct Device {
   std::vector<FrequencyRange> m_ranges{};
   float m_startLevel{};
   float m_stopLevel{};
+  std::string m_replayFile{};
+  bool m_replayRealTime{};
+  bool m_replayLoop{};
+  std::vector<int> m_sourceCores{};
+  std::vector<int> m_detectionCores{};
+  int m_sourcePriority{};
+  SampleFormat m_sampleFormat{SampleFormat::CF32};
 
   std::string getName() const { return m_driver + "_" + m_serial; }
 };
+
+// settings applied to running device without rebuilding it
+struct ScanSettings {
+  float m_startLevel{};
+  float m_stopLevel{};
+  int m_recordersCount{};
+  std::vector<FrequencyRange> m_ranges{};
+  std::vector<FrequencyRange> m_ignoredRanges{};
+};
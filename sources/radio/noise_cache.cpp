@@ -0,0 +1,164 @@
+#include "noise_cache.h"
+
+#include <logger.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+constexpr auto LABEL = "noise";
+constexpr uint32_t MAGIC = 0x31434e41;  // "ANC1"
+constexpr auto SCALE = 100.0f;          // 0.01 dB resolution
+
+namespace {
+struct Header {
+  uint32_t m_magic;
+  uint64_t m_configHash;
+} __attribute__((packed));
+
+struct EntryHeader {
+  int32_t m_frequency;
+  int64_t m_time;
+  uint32_t m_size;
+} __attribute__((packed));
+
+uint64_t fnv1a(const std::string& data) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const auto c : data) {
+    hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+bool writeEntry(FILE* file, const Frequency frequency, const std::chrono::milliseconds time, const std::vector<int16_t>& data) {
+  const EntryHeader header{frequency, time.count(), static_cast<uint32_t>(data.size())};
+  return fwrite(&header, sizeof(header), 1, file) == 1 && fwrite(data.data(), sizeof(int16_t), data.size(), file) == data.size();
+}
+}  // namespace
+
+NoiseCache::NoiseCache(const std::string& path, const uint64_t configHash, const int itemSize, const std::chrono::milliseconds maxAge, const std::chrono::milliseconds now)
+    : m_path(path), m_configHash(configHash), m_itemSize(itemSize), m_maxAge(maxAge), m_superseded(0) {
+  if (!read(now)) {
+    // stale, duplicated or invalid entries, keep only valid ones
+    write(m_entries);
+  }
+  Logger::info(LABEL, "cache: {}, entries: {}", colored(GREEN, "{}", m_path), colored(GREEN, "{}", m_entries.size()));
+}
+
+bool NoiseCache::load(const Frequency frequency, std::vector<float>& threshold, const std::chrono::milliseconds now) const {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  const auto it = m_entries.find(frequency);
+  if (it == m_entries.end() || it->second.m_time + m_maxAge < now) {
+    return false;
+  }
+  threshold.resize(m_itemSize);
+  std::transform(it->second.m_data.begin(), it->second.m_data.end(), threshold.begin(), [](const int16_t value) { return value / SCALE; });
+  return true;
+}
+
+void NoiseCache::store(const Frequency frequency, const std::vector<float>& threshold, const std::chrono::milliseconds now) {
+  if (static_cast<int>(threshold.size()) != m_itemSize) {
+    return;
+  }
+  Entry entry{now, std::vector<int16_t>(m_itemSize)};
+  std::transform(threshold.begin(), threshold.end(), entry.m_data.begin(), [](const float value) {
+    const auto scaled = std::round(value * SCALE);
+    return static_cast<int16_t>(std::clamp<float>(scaled, std::numeric_limits<int16_t>::min(), std::numeric_limits<int16_t>::max()));
+  });
+  std::map<Frequency, Entry> entries;
+  {
+    // file is written outside lock, load does not wait for it
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_entries.count(frequency)) {
+      m_superseded++;
+    }
+    m_entries[frequency] = entry;
+    if (static_cast<int>(m_entries.size()) < m_superseded) {
+      // more superseded than valid entries in file, rewrite it to keep its size bounded
+      m_superseded = 0;
+      entries = m_entries;
+    }
+  }
+  const auto isOk = entries.empty() ? append(frequency, entry) : write(entries);
+  if (!isOk) {
+    Logger::warn(LABEL, "cache write failed: {}", colored(RED, "{}", m_path));
+  }
+}
+
+int NoiseCache::size() const {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  return m_entries.size();
+}
+
+uint64_t NoiseCache::getConfigHash(const Device& device, const int itemSize) {
+  auto data = fmt::format("{}|{}|{}|{}", device.m_driver, device.m_serial, device.m_sampleRate, itemSize);
+  for (const auto& [name, value] : device.m_gains) {
+    data += fmt::format("|{}={}", name, value);
+  }
+  return fnv1a(data);
+}
+
+bool NoiseCache::read(const std::chrono::milliseconds now) {
+  FILE* file = fopen(m_path.c_str(), "rb");
+  if (!file) {
+    return false;
+  }
+  fseek(file, 0, SEEK_END);
+  const auto fileSize = ftell(file);
+  rewind(file);
+  Header header;
+  if (fread(&header, sizeof(header), 1, file) != 1 || header.m_magic != MAGIC || header.m_configHash != m_configHash) {
+    Logger::info(LABEL, "cache invalidated: {}", colored(GREEN, "{}", m_path));
+    fclose(file);
+    return false;
+  }
+  bool isCompact = true;
+  EntryHeader entryHeader;
+  while (fread(&entryHeader, sizeof(entryHeader), 1, file) == 1) {
+    if (static_cast<int>(entryHeader.m_size) != m_itemSize || fileSize - ftell(file) < static_cast<long>(sizeof(int16_t)) * m_itemSize) {
+      // corrupted or truncated entry, following entries can not be located
+      Logger::warn(LABEL, "cache entry invalid: {}, size: {}", colored(RED, "{}", m_path), colored(RED, "{}", entryHeader.m_size));
+      isCompact = false;
+      break;
+    }
+    Entry entry{std::chrono::milliseconds(entryHeader.m_time), std::vector<int16_t>(m_itemSize)};
+    if (fread(entry.m_data.data(), sizeof(int16_t), m_itemSize, file) != static_cast<size_t>(m_itemSize)) {
+      isCompact = false;
+      break;
+    }
+    if (entry.m_time + m_maxAge < now || m_entries.count(entryHeader.m_frequency)) {
+      isCompact = false;
+    }
+    if (now <= entry.m_time + m_maxAge) {
+      m_entries[entryHeader.m_frequency] = std::move(entry);
+    }
+  }
+  fclose(file);
+  return isCompact;
+}
+
+bool NoiseCache::write(const std::map<Frequency, Entry>& entries) const {
+  const auto tmpPath = m_path + ".tmp";
+  FILE* file = fopen(tmpPath.c_str(), "wb");
+  if (!file) {
+    return false;
+  }
+  const Header header{MAGIC, m_configHash};
+  bool isOk = fwrite(&header, sizeof(header), 1, file) == 1;
+  for (const auto& [frequency, entry] : entries) {
+    isOk = isOk && writeEntry(file, frequency, entry.m_time, entry.m_data);
+  }
+  isOk = fclose(file) == 0 && isOk;
+  return isOk && std::rename(tmpPath.c_str(), m_path.c_str()) == 0;
+}
+
+bool NoiseCache::append(const Frequency frequency, const Entry& entry) const {
+  FILE* file = fopen(m_path.c_str(), "ab");
+  if (!file) {
+    return false;
+  }
+  const auto isOk = writeEntry(file, frequency, entry.m_time, entry.m_data);
+  return fclose(file) == 0 && isOk;
+}
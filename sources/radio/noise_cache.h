@@ -0,0 +1,43 @@
+#pragma once
+
+#include <radio/help_structures.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// learned noise thresholds per center frequency, kept in append only file
+// file is dropped when config hash differs, entries are dropped when older than max age
+// file is rewritten when superseded entries outnumber valid ones
+// load is safe while other thread stores, stores must not run concurrently
+class NoiseCache {
+  struct Entry {
+    std::chrono::milliseconds m_time;
+    std::vector<int16_t> m_data;
+  };
+
+ public:
+  NoiseCache(const std::string& path, const uint64_t configHash, const int itemSize, const std::chrono::milliseconds maxAge, const std::chrono::milliseconds now);
+
+  bool load(const Frequency frequency, std::vector<float>& threshold, const std::chrono::milliseconds now) const;
+  void store(const Frequency frequency, const std::vector<float>& threshold, const std::chrono::milliseconds now);
+  int size() const;
+
+  static uint64_t getConfigHash(const Device& device, const int itemSize);
+
+ private:
+  bool read(const std::chrono::milliseconds now);
+  bool write(const std::map<Frequency, Entry>& entries) const;
+  bool append(const Frequency frequency, const Entry& entry) const;
+
+  const std::string m_path;
+  const uint64_t m_configHash;
+  const int m_itemSize;
+  const std::chrono::milliseconds m_maxAge;
+  mutable std::mutex m_mutex;
+  std::map<Frequency, Entry> m_entries;
+  int m_superseded;
+};
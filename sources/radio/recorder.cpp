@@ -11,37 +11,49 @@
 
 constexpr auto LABEL = "recorder";
 
-Recorder::Recorder(const Config& config, std::shared_ptr<gr::top_block> tb, std::shared_ptr<gr::block> source, Frequency sampleRate, DataController& dataController)
+Recorder::Recorder(
+    const Config& config, std::shared_ptr<gr::top_block> tb, std::shared_ptr<Channelizer> channelizer, const int channel, Frequency sampleRate, DataController& dataController)
     : m_config(config),
+      m_channel(channel),
       m_sampleRate(sampleRate),
       m_frequency(std::numeric_limits<Frequency>::max()),
       m_shift(std::numeric_limits<Frequency>::max()),
       m_dataController(dataController),
-      m_connector(tb) {
+      m_channelizer(channelizer),
+      m_connector(tb),
+      m_backfill(0),
+      m_chunkSize(0),
+      m_chunks(0),
+      m_dropped(0) {
   std::vector<Block> blocks;
-  m_blocker = std::make_shared<Blocker>(gr::io_signature::make(1, 1, sizeof(gr_complex)), true);
-  m_shiftBlock = gr::blocks::rotator_cc::make();
-  blocks.push_back(source);
-  blocks.push_back(m_blocker);
-  blocks.push_back(m_shiftBlock);
-
   Block lastResampler;
-  for (const auto& [factor1, factor2] : getResamplersFactors(m_sampleRate, config.recordingBandwidth(), RESAMPLER_THRESHOLD)) {
-    Logger::info(LABEL, "rational resampler factors: {}, {}", colored(GREEN, "{}", factor1), colored(GREEN, "{}", factor2));
-    lastResampler = gr::filter::rational_resampler<gr_complex, gr_complex, gr_complex>::make(factor1, factor2);
-    blocks.push_back(lastResampler);
+  const auto channelBandwidth = config.recordingBandwidth() * m_channelizer->getDecimation();
+  if (channelBandwidth != m_sampleRate) {
+    for (const auto& [factor1, factor2] : getResamplersFactors(m_sampleRate, channelBandwidth, RESAMPLER_THRESHOLD)) {
+      Logger::info(LABEL, "rational resampler factors: {}, {}", colored(GREEN, "{}", factor1), colored(GREEN, "{}", factor2));
+      lastResampler = gr::filter::rational_resampler<gr_complex, gr_complex, gr_complex>::make(factor1, factor2);
+      blocks.push_back(lastResampler);
+    }
   }
 
   const auto samplesSize = roundUp(m_config.recordingBandwidth() * RECORDER_FLUSH_INTERVAL.count() / 1000, 4096);
-  blocks.push_back(gr::blocks::complex_to_interleaved_char::make(true, 127.0));
+  if (!m_channelizer->isSimpleComplexOutput()) {
+    blocks.push_back(gr::blocks::complex_to_interleaved_char::make(true, 127.0));
+  }
   blocks.push_back(gr::blocks::stream_to_vector::make(sizeof(SimpleComplex), samplesSize));
-  m_buffer = std::make_shared<Buffer<SimpleComplex>>("RecorderBuffer", samplesSize);
+  m_chunkSize = samplesSize;
+  m_buffer = std::make_shared<Buffer<SimpleComplex>>("RecorderBuffer", samplesSize, RECORDER_BUFFER_SIZE, Buffer<SimpleComplex>::Policy::Overwrite);
   blocks.push_back(m_buffer);
+  m_connector.connect(m_channelizer, blocks.front(), m_channel, 0);
   m_connector.connect(blocks);
 
   if (DEBUG_SAVE_RECORDING_RAW_IQ) {
     m_rawFileSinkBlock = std::make_shared<FileSink<gr_complex>>(1, true);
-    m_connector.connect(lastResampler, m_rawFileSinkBlock);
+    if (lastResampler) {
+      m_connector.connect(lastResampler, m_rawFileSinkBlock);
+    } else {
+      m_connector.connect(m_channelizer, m_rawFileSinkBlock, m_channel, 0);
+    }
   }
 }
 
@@ -53,7 +65,7 @@ Recorder::~Recorder() {
 
 Frequency Recorder::getShift() { return m_shift; }
 
-bool Recorder::isRecording() { return !m_blocker->isBlocking(); }
+bool Recorder::isRecording() { return m_channelizer->isChannelActive(m_channel); }
 
 void Recorder::startRecording(Frequency frequency, Frequency shift) {
   if (!isRecording()) {
@@ -61,12 +73,14 @@ void Recorder::startRecording(Frequency frequency, Frequency shift) {
     m_lastDataTime = m_firstDataTime;
     m_frequency = frequency;
     m_shift = shift;
-    m_shiftBlock->set_phase_inc(2.0l * M_PIl * (static_cast<double>(-shift) / static_cast<float>(m_sampleRate)));
     if (DEBUG_SAVE_RECORDING_RAW_IQ) {
       m_rawFileSinkBlock->startRecording(getRawFileName("recording", "fc", frequency + shift, m_config.recordingBandwidth()));
     }
-    m_blocker->setBlocking(false);
+    // channel is inactive, so buffer gets nothing until backfill starts
     m_buffer->clear();
+    m_dropped = m_buffer->dropped();
+    m_chunks = 0;
+    m_backfill = m_channelizer->startChannel(m_channel, shift);
   } else {
     Logger::warn(LABEL, "can not start recording, recorder already recording");
   }
@@ -79,8 +93,11 @@ void Recorder::stopRecording() {
     if (DEBUG_SAVE_RECORDING_RAW_IQ) {
       m_rawFileSinkBlock->stopRecording();
     }
-    m_blocker->setBlocking(true);
+    m_channelizer->stopChannel(m_channel);
     m_buffer->clear();
+    if (m_dropped < m_buffer->dropped()) {
+      Logger::warn(LABEL, "dropped samples: {}", colored(YELLOW, "{}", m_buffer->dropped() - m_dropped));
+    }
   } else {
     Logger::warn(LABEL, "can not stop recording, recorder do not recording");
   }
@@ -92,7 +109,11 @@ void Recorder::flush() {
     m_rawFileSinkBlock->flush();
   }
   m_buffer->popSingleSample([this](const SimpleComplex* data, const int size, const std::chrono::milliseconds& time) {
-    m_dataController.pushTransmission(time, m_frequency + m_shift, m_config.recordingBandwidth(), data, size);
+    // backfilled chunks arrive in burst after start, stamp them with time of their last sample instead
+    const auto end = std::chrono::milliseconds(static_cast<int64_t>(m_chunks + 1) * m_chunkSize * 1000 / m_config.recordingBandwidth());
+    const auto chunkTime = end <= m_backfill ? m_firstDataTime - m_backfill + end : time;
+    m_chunks++;
+    m_dataController.pushTransmission(chunkTime, m_frequency + m_shift, m_config.recordingBandwidth(), data, size);
   });
 }
 
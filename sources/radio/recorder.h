@@ -1,10 +1,9 @@
 #pragma once
 
-#include <gnuradio/blocks/rotator_cc.h>
 #include <gnuradio/top_block.h>
 #include <network/data_controller.h>
-#include <radio/blocks/blocker.h>
 #include <radio/blocks/buffer.h>
+#include <radio/blocks/channelizer.h>
 #include <radio/blocks/file_sink.h>
 #include <radio/connector.h>
 #include <radio/help_structures.h>
@@ -20,7 +19,7 @@ class Recorder {
   Recorder(const Recorder&) = delete;
   Recorder& operator=(const Recorder&) = delete;
 
-  Recorder(const Config& config, std::shared_ptr<gr::top_block> tb, std::shared_ptr<gr::block> source, Frequency sampleRate, DataController& dataController);
+  Recorder(const Config& config, std::shared_ptr<gr::top_block> tb, std::shared_ptr<Channelizer> channelizer, const int channel, Frequency sampleRate, DataController& dataController);
   ~Recorder();
 
   Frequency getShift();
@@ -32,16 +31,20 @@ class Recorder {
 
  private:
   const Config& m_config;
+  const int m_channel;
   const Frequency m_sampleRate;
   Frequency m_frequency;
   Frequency m_shift;
   DataController& m_dataController;
 
-  std::shared_ptr<Blocker> m_blocker;
-  std::shared_ptr<gr::blocks::rotator_cc> m_shiftBlock;
+  std::shared_ptr<Channelizer> m_channelizer;
   std::shared_ptr<FileSink<gr_complex>> m_rawFileSinkBlock;
   std::shared_ptr<Buffer<SimpleComplex>> m_buffer;
   Connector m_connector;
   std::chrono::milliseconds m_firstDataTime;
   std::chrono::milliseconds m_lastDataTime;
+  std::chrono::milliseconds m_backfill;
+  int m_chunkSize;
+  int m_chunks;
+  uint64_t m_dropped;
 };
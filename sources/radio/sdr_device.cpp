@@ -3,25 +3,38 @@
 #include <config.h>
 #include <gnuradio/block_detail.h>
 #include <gnuradio/blocks/float_to_char.h>
-#include <gnuradio/blocks/stream_to_vector.h>
 #include <gnuradio/fft/fft_v.h>
 #include <gnuradio/fft/window.h>
 #include <gnuradio/soapy/source.h>
 #include <logger.h>
-#include <radio/blocks/decimator.h>
+#include <metrics.h>
 #include <radio/blocks/psd.h>
 #include <radio/blocks/spectrogram.h>
+#include <utils/thread_utils.h>
 
 constexpr auto LABEL = "sdr";
 
-SdrDevice::SdrDevice(const Config& config, const Device& device, Mqtt& mqtt, TransmissionNotification& notification, const int recordersCount)
-    : m_sampleRate(device.m_sampleRate),
+SdrDevice::SdrDevice(
+    const Config& config,
+    const Device& device,
+    const Snapshot<ScanSettings>& settings,
+    Mqtt& mqtt,
+    TransmissionNotification& notification,
+    const int recordersCount,
+    std::shared_ptr<Source> source)
+    : m_settings(settings),
+      m_sampleRate(device.m_sampleRate),
       m_isInitialized(false),
       m_frequencyRange({0, 0}),
+      m_retuneSequence(0),
       m_dataController(mqtt, device.getName()),
       m_tb(gr::make_top_block("sdr")),
+      m_source(source),
       m_powerFileSink(nullptr),
       m_rawIqFileSink(nullptr),
+      m_retunesMetric(fmt::format("retunes_total{{device=\"{}\"}}", device.getName())),
+      m_activeRecordersMetric(fmt::format("recorders_active{{device=\"{}\"}}", device.getName())),
+      m_idleRecordersMetric(fmt::format("recorders_idle{{device=\"{}\"}}", device.getName())),
       m_connector(m_tb) {
   Logger::info(LABEL, "starting");
   Logger::info(
@@ -32,12 +45,33 @@ SdrDevice::SdrDevice(const Config& config, const Device& device, Mqtt& mqtt, Tra
       formatFrequency(m_sampleRate),
       colored(GREEN, "{}", recordersCount));
 
-  m_source = std::make_shared<SdrSource>(device);
+  if (m_source) {
+    Logger::info(LABEL, "using external source");
+  } else if (device.m_replayFile.empty()) {
+    m_source = std::make_shared<SdrSource>(device);
+  } else {
+    m_source = std::make_shared<FileSource>(device);
+  }
+  Logger::info(
+      LABEL,
+      "source cores: {}, detection cores: {}, source priority: {}",
+      colored(GREEN, "{}", formatCores(device.m_sourceCores)),
+      colored(GREEN, "{}", formatCores(device.m_detectionCores)),
+      colored(GREEN, "{}", device.m_sourcePriority));
+  if (!device.m_sourceCores.empty()) {
+    m_source->set_processor_affinity(device.m_sourceCores);
+  }
   setupChains(config, device, notification);
 
   Logger::info(LABEL, "recording bandwidth: {}", formatFrequency(config.recordingBandwidth()));
+  if (0 < recordersCount) {
+    // without resampling recorders take quantized samples directly from channelizer
+    const auto isSimpleComplexOutput = !DEBUG_SAVE_RECORDING_RAW_IQ && m_sampleRate % config.recordingBandwidth() == 0;
+    m_channelizer = std::make_shared<Channelizer>(m_sampleRate, config.recordingBandwidth(), recordersCount, m_source->getSampleFormat(), m_source->getSampleScale(), isSimpleComplexOutput, config.recordingPreTrigger());
+    m_connector.connect<Block>(m_source, m_channelizer);
+  }
   for (int i = 0; i < recordersCount; ++i) {
-    m_recorders.push_back(std::make_unique<Recorder>(config, m_tb, m_source, m_sampleRate, m_dataController));
+    m_recorders.push_back(std::make_unique<Recorder>(config, m_tb, m_channelizer, i, m_sampleRate, m_dataController));
   }
 
   m_tb->start();
@@ -57,26 +91,26 @@ void SdrDevice::setFrequencyRange(FrequencyRange frequencyRange) {
     std::this_thread::sleep_for(INITIAL_DELAY);
     Logger::info(LABEL, "finished, initial sleep");
     m_isInitialized = true;
-    m_blocker->setBlocking(false);
+    m_frameSelector->setBlocking(false);
   }
 
-  m_blocker->setBlocking(true);
+  m_frameSelector->waitForRetune(++m_retuneSequence);
   if (m_powerFileSink) m_powerFileSink->stopRecording();
   if (m_rawIqFileSink) m_rawIqFileSink->stopRecording();
 
   const auto frequency = (frequencyRange.first + frequencyRange.second) / 2;
-  if (m_source->setCenterFrequency(frequency)) {
-    Logger::debug(LABEL, "set frequency range: {} - {}, center frequency: {}", formatFrequency(frequencyRange.first), formatFrequency(frequencyRange.second), formatFrequency(frequency));
+  Metrics::increment(m_retunesMetric);
+  if (m_source->retune(frequency, m_retuneSequence)) {
+    LOG_DEBUG(LABEL, "set frequency range: {} - {}, center frequency: {}", formatFrequency(frequencyRange.first), formatFrequency(frequencyRange.second), formatFrequency(frequency));
   } else {
     Logger::warn(LABEL, "set frequency range failed: {} - {}, center frequency: {}", formatFrequency(frequencyRange.first), formatFrequency(frequencyRange.second), formatFrequency(frequency));
   }
 
   m_transmission->resetBuffers();
+  m_transmission->setFrequencyRange(frequencyRange);
   if (m_powerFileSink) m_powerFileSink->startRecording(getRawFileName("full", "power", frequency, m_sampleRate));
-  if (m_rawIqFileSink) m_rawIqFileSink->startRecording(getRawFileName("full", "fc", frequency, m_sampleRate));
+  if (m_rawIqFileSink) m_rawIqFileSink->startRecording(getRawFileName("full", getRawFileFormat(m_source->getSampleFormat()), frequency, m_sampleRate));
   m_frequencyRange = frequencyRange;
-  m_blocker->skip();
-  m_blocker->setBlocking(false);
 }
 
 void SdrDevice::updateRecordings(const std::vector<FrequencyFlush> sortedShifts) {
@@ -92,17 +126,21 @@ void SdrDevice::updateRecordings(const std::vector<FrequencyFlush> sortedShifts)
       return recorder->getShift() == shift;
     });
   };
-  const auto getFreeRecorder = [this]() {
-    return std::find_if(m_recorders.begin(), m_recorders.end(), [](const std::unique_ptr<Recorder>& recorder) {
+  // recorders above current count are kept idle until device is rebuilt or count is raised again
+  const auto recordersCount = std::min(static_cast<int>(m_recorders.size()), m_settings.load()->m_recordersCount);
+  const auto getFreeRecorder = [this, recordersCount]() {
+    const auto it = std::find_if(m_recorders.begin(), m_recorders.begin() + recordersCount, [](const std::unique_ptr<Recorder>& recorder) {
       // improve auto formatter
       return !recorder->isRecording();
     });
+    return it != m_recorders.begin() + recordersCount ? it : m_recorders.end();
   };
 
-  for (auto& recorder : m_recorders) {
+  for (int i = 0; i < static_cast<int>(m_recorders.size()); ++i) {
+    const auto& recorder = m_recorders[i];
     if (recorder->isRecording()) {
       const auto shift = recorder->getShift();
-      if (!isWaitingForRecording(shift)) {
+      if (!isWaitingForRecording(shift) || recordersCount <= i) {
         recorder->stopRecording();
         Logger::info(LABEL, "stop recorder, frequency: {}, time: {} ms", formatFrequency(getFrequency() + shift, RED), recorder->getDuration().count());
       }
@@ -141,6 +179,10 @@ void SdrDevice::updateRecordings(const std::vector<FrequencyFlush> sortedShifts)
       ignoredTransmissions.erase(it++);
     }
   }
+
+  const auto active = std::count_if(m_recorders.begin(), m_recorders.end(), [](const std::unique_ptr<Recorder>& recorder) { return recorder->isRecording(); });
+  Metrics::set(m_activeRecordersMetric, active);
+  Metrics::set(m_idleRecordersMetric, recordersCount - active);
 }
 
 Frequency SdrDevice::getFrequency() const { return (m_frequencyRange.first + m_frequencyRange.second) / 2; }
@@ -149,34 +191,35 @@ void SdrDevice::setupChains(const Config& config, const Device& device, Transmis
   const auto fftSize = getFft(m_sampleRate, SIGNAL_DETECTION_MAX_STEP);
   const auto step = static_cast<double>(m_sampleRate) / fftSize;
   const auto indexStep = static_cast<Frequency>(std::ceil(config.recordingBandwidth() / (static_cast<double>(m_sampleRate) / fftSize)));
-  const auto decimatorFactor = std::max(1, static_cast<int>(step / SIGNAL_DETECTION_FPS));
+  const auto decimatorFactor = std::max(1, static_cast<int>(step / config.detectionFps()));
   const auto indexToFrequency = [this, step](const int index) { return getFrequency() + static_cast<Frequency>(step * (index + 0.5)) - m_sampleRate / 2; };
-  const auto indexToShift = [this, step](const int index) { return static_cast<Frequency>(step * (index + 0.5)) - m_sampleRate / 2; };
-  const auto isIndexInRange = [this, indexToFrequency](const int index) {
-    const auto f = indexToFrequency(index);
-    return m_frequencyRange.first <= f && f <= m_frequencyRange.second;
-  };
   Logger::info(LABEL, "signal detection, fft: {}, step: {}, decimator factor: {}", colored(GREEN, "{}", fftSize), formatFrequency(step), colored(GREEN, "{}", decimatorFactor));
 
-  const auto s2c = gr::blocks::stream_to_vector::make(sizeof(gr_complex), fftSize * decimatorFactor);
-  m_blocker = std::make_shared<Blocker>(gr::io_signature::make(1, 1, sizeof(gr_complex) * fftSize * decimatorFactor), true);
-  const auto decimator = std::make_shared<Decimator<gr_complex>>(fftSize, decimatorFactor);
+  const auto settle = static_cast<int>(static_cast<int64_t>(m_sampleRate) * RETUNE_SETTLE_TIME.count() / 1000);
+  m_frameSelector = std::make_shared<FrameSelector>(fftSize, fftSize * decimatorFactor, settle, true, m_source->getSampleFormat(), m_source->getSampleScale(), device.getName());
   const auto fft = gr::fft::fft_v<gr_complex, true>::make(fftSize, gr::fft::window::hamming(fftSize), true);
-  const auto psd = std::make_shared<PSD>(fftSize, m_sampleRate);
-  m_noiseLearner = std::make_shared<NoiseLearner>(fftSize, std::bind(&SdrDevice::getFrequency, this), indexToFrequency);
-  m_transmission = std::make_shared<Transmission>(config, device, fftSize, indexStep, notification, indexToFrequency, indexToShift, isIndexInRange);
-  m_connector.connect<Block>(m_source, s2c, m_blocker, decimator, fft, psd, m_noiseLearner, m_transmission);
+  const auto psd = std::make_shared<PSD>(fftSize, m_sampleRate, device.getName());
+  const auto noiseCache = std::make_shared<NoiseCache>(fmt::format("noise_{}.cache", device.getName()), NoiseCache::getConfigHash(device, fftSize), fftSize, NOISE_CACHE_MAX_AGE, getTime());
+  m_noiseLearner = std::make_shared<NoiseLearner>(fftSize, std::bind(&SdrDevice::getFrequency, this), indexToFrequency, noiseCache, config.housekeepingCores());
+  m_transmission = std::make_shared<Transmission>(config, device, m_settings, fftSize, indexStep, m_sampleRate, notification);
+  m_connector.connect<Block>(m_source, m_frameSelector, fft, psd, m_noiseLearner, m_transmission);
 
   const auto spectrogram = std::make_shared<Spectrogram>(fftSize, m_sampleRate, m_dataController, std::bind(&SdrDevice::getFrequency, this));
   m_connector.connect<Block>(psd, spectrogram);
 
+  if (!device.m_detectionCores.empty()) {
+    for (const auto& block : std::vector<std::shared_ptr<gr::block>>{m_frameSelector, fft, psd, m_noiseLearner, m_transmission, spectrogram}) {
+      block->set_processor_affinity(device.m_detectionCores);
+    }
+  }
+
   if (DEBUG_SAVE_FULL_POWER) {
     m_powerFileSink = std::make_shared<FileSink<float>>(fftSize, false);
     m_connector.connect<Block>(psd, m_powerFileSink);
   }
 
   if (DEBUG_SAVE_FULL_RAW_IQ) {
-    m_rawIqFileSink = std::make_shared<FileSink<gr_complex>>(1, false);
+    m_rawIqFileSink = std::make_shared<FileSink<uint8_t>>(getSampleSize(m_source->getSampleFormat()), false);
     m_connector.connect<Block>(m_source, m_rawIqFileSink);
   }
 }
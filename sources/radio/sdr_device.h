@@ -5,13 +5,16 @@
 #include <network/data_controller.h>
 #include <network/mqtt.h>
 #include <notification.h>
-#include <radio/blocks/blocker.h>
+#include <radio/blocks/channelizer.h>
 #include <radio/blocks/file_sink.h>
+#include <radio/blocks/file_source.h>
+#include <radio/blocks/frame_selector.h>
 #include <radio/blocks/noise_learner.h>
 #include <radio/blocks/sdr_source.h>
 #include <radio/blocks/transmission.h>
 #include <radio/help_structures.h>
 #include <radio/recorder.h>
+#include <utils/snapshot.h>
 
 #include <map>
 #include <memory>
@@ -20,7 +23,14 @@
 
 class SdrDevice {
  public:
-  SdrDevice(const Config& config, const Device& device, Mqtt& mqtt, TransmissionNotification& notification, const int recordersCount);
+  SdrDevice(
+      const Config& config,
+      const Device& device,
+      const Snapshot<ScanSettings>& settings,
+      Mqtt& mqtt,
+      TransmissionNotification& notification,
+      const int recordersCount,
+      std::shared_ptr<Source> source = nullptr);
   ~SdrDevice();
 
   void setFrequencyRange(FrequencyRange frequencyRange);
@@ -30,19 +40,25 @@ class SdrDevice {
   Frequency getFrequency() const;
   void setupChains(const Config& config, const Device& device, TransmissionNotification& notification);
 
+  const Snapshot<ScanSettings>& m_settings;
   const Frequency m_sampleRate;
   bool m_isInitialized;
   FrequencyRange m_frequencyRange;
+  uint64_t m_retuneSequence;
   DataController m_dataController;
 
   std::shared_ptr<gr::top_block> m_tb;
-  std::shared_ptr<SdrSource> m_source;
-  std::shared_ptr<Blocker> m_blocker;
+  std::shared_ptr<Source> m_source;
+  std::shared_ptr<FrameSelector> m_frameSelector;
   std::shared_ptr<NoiseLearner> m_noiseLearner;
   std::shared_ptr<Transmission> m_transmission;
+  std::shared_ptr<Channelizer> m_channelizer;
   std::vector<std::unique_ptr<Recorder>> m_recorders;
   std::shared_ptr<FileSink<float>> m_powerFileSink;
-  std::shared_ptr<FileSink<gr_complex>> m_rawIqFileSink;
+  std::shared_ptr<FileSink<uint8_t>> m_rawIqFileSink;
   std::set<Frequency> ignoredTransmissions;
+  const std::string m_retunesMetric;
+  const std::string m_activeRecordersMetric;
+  const std::string m_idleRecordersMetric;
   Connector m_connector;
 };
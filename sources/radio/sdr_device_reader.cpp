@@ -1,35 +1,117 @@
 #include "sdr_device_reader.h"
 
+#include <SoapySDR/Formats.h>
 #include <config.h>
 #include <logger.h>
+#include <radio/blocks/sdr_source.h>
+#include <radio/soapy_device_cache.h>
+#include <utils/radio_utils.h>
 #include <utils/utils.h>
 
+#include <algorithm>
 #include <set>
 
 constexpr auto LABEL = "config";
 
-std::set<Frequency> getSampleRates(SoapySDR::Device* sdr) {
+nlohmann::json probeDevice(const SoapySDR::Kwargs& args) {
+  SoapySDR::Device* sdr = SoapySDR::Device::make(args);
+  if (sdr == nullptr) {
+    throw std::runtime_error("open device failed");
+  }
+
+  nlohmann::json capabilities;
   std::set<Frequency> sampleRates;
   for (const auto value : sdr->listSampleRates(SOAPY_SDR_RX, 0)) {
-    const auto sampleRate = static_cast<Frequency>(value);
+    sampleRates.insert(static_cast<Frequency>(value));
+  }
+  capabilities["sample_rates"] = sampleRates;
+
+  double fullScale = 0.0;
+  capabilities["native_format"] = sdr->getNativeStreamFormat(SOAPY_SDR_RX, 0, fullScale);
+  capabilities["full_scale"] = fullScale;
+  capabilities["formats"] = sdr->getStreamFormats(SOAPY_SDR_RX, 0);
+
+  capabilities["gains"] = nlohmann::json::array();
+  for (const auto& gain : sdr->listGains(SOAPY_SDR_RX, 0)) {
+    const auto gainRange = sdr->getGainRange(SOAPY_SDR_RX, 0, gain);
+    capabilities["gains"].push_back({{"name", gain}, {"min", gainRange.minimum()}, {"max", gainRange.maximum()}, {"step", gainRange.step()}});
+  }
+
+  SoapySDR::Device::unmake(sdr);
+  return capabilities;
+}
+
+nlohmann::json getCapabilities(const SoapySDR::Kwargs& args) {
+  static SoapyDeviceCache cache(DEVICE_CACHE_FILE_NAME);
+  if (const auto capabilities = cache.get(args)) {
+    Logger::info(LABEL, "  using cached capabilities");
+    return *capabilities;
+  }
+  const auto previous = cache.getPrevious(args);
+  if (SdrSource::isOpened(args.at("driver"), args.at("serial"))) {
+    // probing would open device again while running source holds it
+    if (previous) {
+      Logger::info(LABEL, "  device opened, using previous capabilities");
+      return *previous;
+    }
+    throw std::runtime_error("device opened, can not probe capabilities");
+  }
+  try {
+    const auto capabilities = probeDevice(args);
+    cache.store(args, capabilities);
+    return capabilities;
+  } catch (const std::exception& exception) {
+    if (!previous) {
+      throw;
+    }
+    Logger::warn(LABEL, "  probe device failed: {}, using previous capabilities", exception.what());
+    return *previous;
+  }
+}
+
+std::set<Frequency> getSampleRates(const nlohmann::json& capabilities) {
+  const auto sampleRates = capabilities.at("sample_rates").get<std::set<Frequency>>();
+  if (sampleRates.empty()) {
+    throw std::runtime_error("no supported sample rates");
+  }
+  for (const auto sampleRate : sampleRates) {
     Logger::info(LABEL, "  supported sample rate: {}", formatFrequency(sampleRate));
-    sampleRates.insert(sampleRate);
   }
   return sampleRates;
 }
 
-std::vector<nlohmann::json> getGains(SoapySDR::Device* sdr) {
+std::string getNativeSampleFormat(const nlohmann::json& capabilities) {
+  const auto format = capabilities.at("native_format").get<std::string>();
+  const auto fullScale = capabilities.at("full_scale").get<double>();
+  Logger::info(LABEL, "  native sample format: {}, full scale: {}", colored(GREEN, "{}", format), colored(GREEN, "{}", fullScale));
+  if (format == SOAPY_SDR_CS8) {
+    return getSampleFormatName(SampleFormat::CS8);
+  } else if (format == SOAPY_SDR_CS16) {
+    return getSampleFormatName(SampleFormat::CS16);
+  } else {
+    return getSampleFormatName(SampleFormat::CF32);
+  }
+}
+
+bool isSampleFormatSupported(const nlohmann::json& capabilities, std::string name) {
+  std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+  const auto formats = capabilities.at("formats").get<std::vector<std::string>>();
+  return std::find(formats.begin(), formats.end(), name) != formats.end();
+}
+
+std::vector<nlohmann::json> getGains(const nlohmann::json& capabilities) {
   std::vector<nlohmann::json> gains;
-  for (const auto& gain : sdr->listGains(SOAPY_SDR_RX, 0)) {
-    const auto gainRange = sdr->getGainRange(SOAPY_SDR_RX, 0, gain);
+  for (const auto& gain : capabilities.at("gains")) {
+    const auto name = gain.at("name").get<std::string>();
+    const auto max = gain.at("max").get<double>();
     Logger::info(
         LABEL,
         "  supported gain: {}, min: {}, max: {}, step: {}",
-        colored(GREEN, "{}", gain),
-        colored(GREEN, "{}", gainRange.minimum()),
-        colored(GREEN, "{}", gainRange.maximum()),
-        colored(GREEN, "{}", gainRange.step()));
-    gains.push_back({{"name", gain}, {"value", gainRange.maximum()}});
+        colored(GREEN, "{}", name),
+        colored(GREEN, "{}", gain.at("min").get<double>()),
+        colored(GREEN, "{}", max),
+        colored(GREEN, "{}", gain.at("step").get<double>()));
+    gains.push_back({{"name", name}, {"value", max}});
   }
   return gains;
 }
@@ -39,21 +121,22 @@ void SdrDeviceReader::updateSoapyDevice(nlohmann::json& json, const SoapySDR::Kw
   const auto driver = args.at("driver");
   Logger::info(LABEL, "update device, driver: {}, serial: {}", colored(GREEN, "{}", driver), colored(GREEN, "{}", serial));
 
-  SoapySDR::Device* sdr = SoapySDR::Device::make(args);
-  if (sdr == nullptr) {
-    throw std::runtime_error("open device failed");
-  }
+  const auto capabilities = getCapabilities(args);
 
   json["driver"] = driver;
 
   const auto sampleRate = json.at("sample_rate").get<Frequency>();
-  const auto sampleRates = getSampleRates(sdr);
+  const auto sampleRates = getSampleRates(capabilities);
   json["sample_rates"] = sampleRates;
   if (sampleRates.count(sampleRate) == 0) {
     json["sample_rate"] = getNearestElement(sampleRates, sampleRate);
   }
 
-  SoapySDR::Device::unmake(sdr);
+  const auto sampleFormat = json.at("sample_format").get<std::string>();
+  if (!isSampleFormatSupported(capabilities, sampleFormat)) {
+    Logger::warn(LABEL, "sample format not supported: {}, using: {}", colored(RED, "{}", sampleFormat), colored(GREEN, "{}", getSampleFormatName(SampleFormat::CF32)));
+    json["sample_format"] = getSampleFormatName(SampleFormat::CF32);
+  }
 }
 
 void SdrDeviceReader::createSoapyDevices(nlohmann::json& json, const SoapySDR::Kwargs args) {
@@ -61,18 +144,19 @@ void SdrDeviceReader::createSoapyDevices(nlohmann::json& json, const SoapySDR::K
   const auto driver = args.at("driver");
   Logger::info(LABEL, "creating device, driver: {}, serial: {}", colored(GREEN, "{}", driver), colored(GREEN, "{}", serial));
 
-  SoapySDR::Device* sdr = SoapySDR::Device::make(args);
-  if (sdr == nullptr) {
-    throw std::runtime_error("open device failed");
-  }
+  const auto capabilities = getCapabilities(args);
 
   json["driver"] = driver;
   json["serial"] = serial;
   json["enabled"] = true;
   json["start_recording_level"] = DEFAULT_RECORDING_START_LEVEL;
   json["stop_recording_level"] = DEFAULT_RECORDING_STOP_LEVEL;
+  json["source_cores"] = nlohmann::json::array();
+  json["detection_cores"] = nlohmann::json::array();
+  json["source_priority"] = 0;
+  json["sample_format"] = getNativeSampleFormat(capabilities);
 
-  const auto sampleRates = getSampleRates(sdr);
+  const auto sampleRates = getSampleRates(capabilities);
   json["sample_rates"] = sampleRates;
 
   json["ranges"] = nlohmann::json::array();
@@ -94,9 +178,7 @@ void SdrDeviceReader::createSoapyDevices(nlohmann::json& json, const SoapySDR::K
   addSampleRate(144000000, 146000000, 1000000);
   addSampleRate(144000000, 146000000, *sampleRates.rbegin());
 
-  json["gains"] = getGains(sdr);
-
-  SoapySDR::Device::unmake(sdr);
+  json["gains"] = getGains(capabilities);
 }
 
 void SdrDeviceReader::scanSoapyDevices(nlohmann::json& json) {
@@ -104,18 +186,31 @@ void SdrDeviceReader::scanSoapyDevices(nlohmann::json& json) {
   const SoapySDR::KwargsList results = SoapySDR::Device::enumerate("remote=");
   Logger::info(LABEL, "found {} devices:", colored(GREEN, "{}", results.size()));
 
+  std::set<std::string> serials;
+  for (const auto& result : results) {
+    if (result.count("serial")) {
+      serials.insert(result.at("serial"));
+    }
+  }
   for (auto& device : json.at("devices")) {
-    device["driver"] = "";
-    device["sample_rates"] = nlohmann::json::array();
+    const auto isEnumerated = !device.contains("replay") && device.contains("serial") && serials.count(device.at("serial").get<std::string>());
+    const auto isOpened = device.contains("driver") && device.contains("serial") && SdrSource::isOpened(device.at("driver"), device.at("serial"));
+    if ((!isEnumerated && !isOpened) || !device.contains("driver")) {
+      device["driver"] = "";
+      device["sample_rates"] = nlohmann::json::array();
+    }
   }
   for (uint32_t i = 0; i < results.size(); ++i) {
     try {
       auto& devices = json.at("devices");
       const auto serial = results[i].at("serial");
-      const auto f = [serial](nlohmann::json& device) { return device.at("serial").get<std::string>() == serial; };
+      const auto f = [serial](nlohmann::json& device) { return !device.contains("replay") && device.at("serial").get<std::string>() == serial; };
       const auto it = std::find_if(devices.begin(), devices.end(), f);
       if (it != devices.end()) {
-        updateSoapyDevice(*it, results[i]);
+        // device keeps previous driver and capabilities if update fails
+        auto device = *it;
+        updateSoapyDevice(device, results[i]);
+        *it = device;
       } else {
         nlohmann::json device;
         createSoapyDevices(device, results[i]);
@@ -127,7 +222,38 @@ void SdrDeviceReader::scanSoapyDevices(nlohmann::json& json) {
   }
 }
 
+void readThreads(const nlohmann::json& json, Device& device) {
+  device.m_sourceCores = json.at("source_cores").get<std::vector<int>>();
+  device.m_detectionCores = json.at("detection_cores").get<std::vector<int>>();
+  device.m_sourcePriority = json.at("source_priority").get<int>();
+}
+
+Device SdrDeviceReader::readReplayDevice(const nlohmann::json& json) {
+  Device device;
+  const auto& replay = json.at("replay");
+  device.m_replayFile = replay.at("file").get<std::string>();
+  device.m_replayRealTime = replay.at("real_time").get<bool>();
+  device.m_replayLoop = replay.at("loop").get<bool>();
+  const auto info = parseRawFileName(device.m_replayFile);
+  if (!info) {
+    throw std::runtime_error("invalid replay file name: " + device.m_replayFile);
+  }
+  device.m_driver = "replay";
+  device.m_serial = std::to_string(info->m_frequency);
+  device.m_enabled = json.at("enabled").get<bool>();
+  device.m_startLevel = json.at("start_recording_level").get<float>();
+  device.m_stopLevel = json.at("stop_recording_level").get<float>();
+  device.m_sampleRate = info->m_sampleRate;
+  const auto bandwidth = getRangeSplitSampleRate(info->m_sampleRate);
+  device.m_ranges.emplace_back(info->m_frequency - bandwidth / 2, info->m_frequency + bandwidth / 2);
+  readThreads(json, device);
+  return device;
+}
+
 Device SdrDeviceReader::readDevice(const nlohmann::json& json) {
+  if (json.contains("replay")) {
+    return readReplayDevice(json);
+  }
   Device device;
   device.m_driver = json.at("driver").get<std::string>();
   device.m_enabled = json.at("enabled").get<bool>();
@@ -140,11 +266,17 @@ Device SdrDeviceReader::readDevice(const nlohmann::json& json) {
   }
   device.m_serial = json.at("serial").get<std::string>();
   device.m_sampleRate = json.at("sample_rate").get<Frequency>();
+  const auto sampleFormat = parseSampleFormat(json.at("sample_format").get<std::string>());
+  if (!sampleFormat) {
+    throw std::runtime_error("invalid sample format: " + json.at("sample_format").get<std::string>());
+  }
+  device.m_sampleFormat = *sampleFormat;
   for (const auto& item : json.at("ranges")) {
     const auto start = item.at("start").get<Frequency>();
     const auto stop = item.at("stop").get<Frequency>();
     device.m_ranges.emplace_back(start, stop);
   }
+  readThreads(json, device);
   return device;
 }
 
@@ -10,6 +10,7 @@ class SdrDeviceReader {
  private:
   static void updateSoapyDevice(nlohmann::json& json, const SoapySDR::Kwargs args);
   static void createSoapyDevices(nlohmann::json& json, const SoapySDR::Kwargs args);
+  static Device readReplayDevice(const nlohmann::json& json);
   static Device readDevice(const nlohmann::json& json);
 
  public:
@@ -3,22 +3,17 @@
 #include <config.h>
 #include <utils/utils.h>
 
-Signal::Signal(
-    const Config& config,
-    const Device& device,
-    const std::function<Frequency(const Index index)>& indexToFrequency,
-    const std::function<Frequency(const Index index)>& indexToShift,
-    const std::chrono::milliseconds& now)
-    : m_config(config), m_device(device), m_indexToFrequency(indexToFrequency), m_indexToShift(indexToShift), m_firstDataTime(now), m_lastDataTime(now), m_power(0.0) {}
+Signal::Signal(const Config& config, const std::chrono::milliseconds& now)
+    : m_config(config), m_firstDataTime(now), m_lastDataTime(now), m_power(0.0) {}
 
 Signal::~Signal() {}
 
-void Signal::newData(const Index avgIndex, const float avgPower, const Index, const float, const std::chrono::milliseconds& now) {
+void Signal::newData(const Index avgIndex, const float avgPower, const Index, const float, const ScanSettings& settings, const std::chrono::milliseconds& now) {
   m_power = avgPower;
-  if (m_device.m_stopLevel <= avgPower) {
+  if (settings.m_stopLevel <= avgPower) {
     m_lastDataTime = now;
   }
-  if (m_device.m_startLevel <= avgPower) {
+  if (settings.m_startLevel <= avgPower) {
     m_indexes.push_back(avgIndex);
   }
 }
@@ -4,21 +4,15 @@
 #include <radio/help_structures.h>
 
 #include <chrono>
-#include <functional>
 
 class Signal {
   using Index = int;
 
  public:
-  Signal(
-      const Config& config,
-      const Device& device,
-      const std::function<Frequency(const Index index)>& indexToFrequency,
-      const std::function<Frequency(const Index index)>& indexToShift,
-      const std::chrono::milliseconds& now);
+  Signal(const Config& config, const std::chrono::milliseconds& now);
   ~Signal();
 
-  void newData(const Index avgIndex, const float avgPower, const Index rawIndex, const float rawPower, const std::chrono::milliseconds& now);
+  void newData(const Index avgIndex, const float avgPower, const Index rawIndex, const float rawPower, const ScanSettings& settings, const std::chrono::milliseconds& now);
 
   bool isMinimalTime(const std::chrono::milliseconds& now) const;
   bool isMaximalTime(const std::chrono::milliseconds& now) const;
@@ -31,9 +25,6 @@ class Signal {
 
  private:
   const Config& m_config;
-  const Device& m_device;
-  std::function<Frequency(const Index index)> m_indexToFrequency;
-  std::function<Frequency(const Index index)> m_indexToShift;
   std::chrono::milliseconds m_firstDataTime;
   std::chrono::milliseconds m_lastDataTime;
   float m_power;
@@ -0,0 +1,84 @@
+#include "soapy_device_cache.h"
+
+#include <logger.h>
+
+#include <cstdio>
+
+constexpr auto LABEL = "config";
+
+namespace {
+std::string getArg(const SoapySDR::Kwargs& args, const std::string& key) {
+  const auto it = args.find(key);
+  return it != args.end() ? it->second : "";
+}
+}  // namespace
+
+SoapyDeviceCache::SoapyDeviceCache(const std::string& path) : m_path(path) {
+  if (read()) {
+    Logger::info(LABEL, "device cache loaded, entries: {}", colored(GREEN, "{}", m_entries.size()));
+  }
+}
+
+std::optional<nlohmann::json> SoapyDeviceCache::get(const SoapySDR::Kwargs& args) const {
+  const auto it = m_entries.find(getKey(args));
+  if (it == m_entries.end() || it->second.at("args") != nlohmann::json(args)) {
+    return std::nullopt;
+  }
+  return it->second.at("capabilities");
+}
+
+std::optional<nlohmann::json> SoapyDeviceCache::getPrevious(const SoapySDR::Kwargs& args) const {
+  const auto it = m_entries.find(getKey(args));
+  if (it == m_entries.end()) {
+    return std::nullopt;
+  }
+  return it->second.at("capabilities");
+}
+
+void SoapyDeviceCache::store(const SoapySDR::Kwargs& args, const nlohmann::json& capabilities) {
+  m_entries[getKey(args)] = {{"args", args}, {"capabilities", capabilities}};
+  if (!write()) {
+    Logger::warn(LABEL, "save device cache failed: {}", m_path);
+  }
+}
+
+int SoapyDeviceCache::size() const { return m_entries.size(); }
+
+std::string SoapyDeviceCache::getKey(const SoapySDR::Kwargs& args) { return getArg(args, "driver") + "_" + getArg(args, "serial"); }
+
+bool SoapyDeviceCache::read() {
+  if (m_path.empty()) {
+    return false;
+  }
+  FILE* file = fopen(m_path.c_str(), "r");
+  if (!file) {
+    return false;
+  }
+  const auto json = nlohmann::json::parse(file, nullptr, false);
+  fclose(file);
+  if (!json.is_object()) {
+    Logger::warn(LABEL, "invalid device cache, ignoring: {}", m_path);
+    return false;
+  }
+  for (const auto& [key, entry] : json.items()) {
+    if (entry.contains("args") && entry.contains("capabilities")) {
+      m_entries[key] = entry;
+    }
+  }
+  return true;
+}
+
+bool SoapyDeviceCache::write() const {
+  if (m_path.empty()) {
+    return true;
+  }
+  // interrupted write leaves previous file intact
+  const auto tmpPath = m_path + ".tmp";
+  FILE* file = fopen(tmpPath.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+  const auto data = nlohmann::json(m_entries).dump();
+  const auto isWritten = fwrite(data.c_str(), 1, data.size(), file) == data.size();
+  return fclose(file) == 0 && isWritten && std::rename(tmpPath.c_str(), m_path.c_str()) == 0;
+}
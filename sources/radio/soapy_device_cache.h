@@ -0,0 +1,29 @@
+#pragma once
+
+#include <SoapySDR/Types.hpp>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+
+// probed soapy device capabilities per driver and serial, kept in json file
+// entry is valid only as long as device is enumerated with the same arguments
+class SoapyDeviceCache {
+ public:
+  SoapyDeviceCache(const std::string& path);
+
+  std::optional<nlohmann::json> get(const SoapySDR::Kwargs& args) const;
+  // last stored capabilities of same driver and serial, even if enumerated with different arguments
+  std::optional<nlohmann::json> getPrevious(const SoapySDR::Kwargs& args) const;
+  void store(const SoapySDR::Kwargs& args, const nlohmann::json& capabilities);
+  int size() const;
+
+  static std::string getKey(const SoapySDR::Kwargs& args);
+
+ private:
+  bool read();
+  bool write() const;
+
+  const std::string m_path;
+  std::map<std::string, nlohmann::json> m_entries;
+};
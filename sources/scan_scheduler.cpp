@@ -0,0 +1,70 @@
+#include "scan_scheduler.h"
+
+#include <config.h>
+
+#include <algorithm>
+#include <cmath>
+
+ScanScheduler::Statistics::Statistics() : m_visits(0), m_detections(0), m_occupancy(0.0), m_lastVisit(0), m_lastHit(0) {}
+
+ScanScheduler::ScanScheduler(
+    const int rangesCount, std::chrono::milliseconds minDwell, std::chrono::milliseconds maxDwell, std::chrono::milliseconds minRevisit, std::chrono::milliseconds maxRevisit)
+    : m_minDwell(minDwell), m_maxDwell(std::max(minDwell, maxDwell)), m_minRevisit(minRevisit), m_maxRevisit(maxRevisit), m_statistics(rangesCount) {}
+
+int ScanScheduler::next(const std::chrono::milliseconds now) const {
+  const auto size = static_cast<int>(m_statistics.size());
+  for (int i = 0; i < size; ++i) {
+    if (m_statistics[i].m_visits == 0) {
+      return i;
+    }
+  }
+
+  int oldest = 0;
+  for (int i = 1; i < size; ++i) {
+    if (m_statistics[i].m_lastVisit < m_statistics[oldest].m_lastVisit) {
+      oldest = i;
+    }
+  }
+  if (m_maxRevisit <= now - m_statistics[oldest].m_lastVisit) {
+    return oldest;
+  }
+
+  int best = -1;
+  double bestPriority = 0.0;
+  for (int i = 0; i < size; ++i) {
+    const auto waiting = now - m_statistics[i].m_lastVisit;
+    if (waiting < m_minRevisit) {
+      continue;
+    }
+    const auto priority = waiting.count() * (1.0 + (SCANNING_BUSY_WEIGHT - 1.0) * getActivity(m_statistics[i], now));
+    if (best == -1 || bestPriority < priority) {
+      best = i;
+      bestPriority = priority;
+    }
+  }
+  return best == -1 ? oldest : best;
+}
+
+std::chrono::milliseconds ScanScheduler::getDwellTime(const int index, const std::chrono::milliseconds now) const {
+  const auto activity = getActivity(m_statistics[index], now);
+  return m_minDwell + std::chrono::milliseconds(static_cast<int64_t>((m_maxDwell - m_minDwell).count() * activity));
+}
+
+void ScanScheduler::report(const int index, const bool isDetected, const double occupancy, const std::chrono::milliseconds now) {
+  auto& statistics = m_statistics[index];
+  statistics.m_occupancy = statistics.m_visits == 0 ? occupancy : (1.0 - SCANNING_OCCUPANCY_SMOOTHING) * statistics.m_occupancy + SCANNING_OCCUPANCY_SMOOTHING * occupancy;
+  statistics.m_visits++;
+  statistics.m_lastVisit = now;
+  if (isDetected) {
+    statistics.m_detections++;
+    statistics.m_lastHit = now;
+  }
+}
+
+double ScanScheduler::getActivity(const Statistics& statistics, const std::chrono::milliseconds now) const {
+  if (statistics.m_detections == 0) {
+    return 0.0;
+  }
+  const auto recency = std::exp2(-static_cast<double>((now - statistics.m_lastHit).count()) / std::chrono::duration_cast<std::chrono::milliseconds>(SCANNING_ACTIVITY_DECAY).count());
+  return std::clamp(std::max(statistics.m_occupancy, recency), 0.0, 1.0);
+}
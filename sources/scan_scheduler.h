@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+// picks next range to scan from per range activity, busy ranges are visited more often and longer
+// every range is visited at least once per max revisit time
+class ScanScheduler {
+  struct Statistics {
+    Statistics();
+
+    int m_visits;
+    int m_detections;
+    double m_occupancy;
+    std::chrono::milliseconds m_lastVisit;
+    std::chrono::milliseconds m_lastHit;
+  };
+
+ public:
+  ScanScheduler(const int rangesCount, std::chrono::milliseconds minDwell, std::chrono::milliseconds maxDwell, std::chrono::milliseconds minRevisit, std::chrono::milliseconds maxRevisit);
+
+  int next(const std::chrono::milliseconds now) const;
+  std::chrono::milliseconds getDwellTime(const int index, const std::chrono::milliseconds now) const;
+  void report(const int index, const bool isDetected, const double occupancy, const std::chrono::milliseconds now);
+
+ private:
+  double getActivity(const Statistics& statistics, const std::chrono::milliseconds now) const;
+
+  const std::chrono::milliseconds m_minDwell;
+  const std::chrono::milliseconds m_maxDwell;
+  const std::chrono::milliseconds m_minRevisit;
+  const std::chrono::milliseconds m_maxRevisit;
+  std::vector<Statistics> m_statistics;
+};
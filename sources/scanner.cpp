@@ -2,28 +2,37 @@
 
 #include <config.h>
 #include <logger.h>
+#include <utils/thread_utils.h>
 
 constexpr auto LABEL = "scanner";
 
-Scanner::Scanner(const Config& config, const Device& device, Mqtt& mqtt, const int recordersCount)
-    : m_device(config, device, mqtt, m_notification, recordersCount),
-      m_ranges(splitRanges(device.m_ranges, getRangeSplitSampleRate(device.m_sampleRate))),
+namespace {
+std::shared_ptr<const ScanSettings> getSettings(const Config& config, const Device& device, const int recordersCount) {
+  auto settings = config.scanSettings(device);
+  settings.m_recordersCount = recordersCount;
+  return std::make_shared<const ScanSettings>(std::move(settings));
+}
+}  // namespace
+
+Scanner::Scanner(const Config& config, const Device& device, Mqtt& mqtt, const int recordersCount, std::shared_ptr<Source> source)
+    : m_sampleRate(device.m_sampleRate),
+      m_minDwell(config.scanningMinDwell()),
+      m_maxDwell(config.scanningMaxDwell()),
+      m_minRevisit(config.scanningMinRevisit()),
+      m_maxRevisit(config.scanningMaxRevisit()),
+      m_settings(getSettings(config, device, recordersCount)),
+      m_device(config, device, m_settings, mqtt, m_notification, recordersCount, source),
       m_isRunning(true),
       m_thread([this]() { worker(); }) {
   Logger::info(LABEL, "starting");
+  if (!setThreadAffinity(m_thread.native_handle(), config.housekeepingCores())) {
+    Logger::warn(LABEL, "set thread affinity failed, cores: {}", colored(RED, "{}", formatCores(config.housekeepingCores())));
+  }
   Logger::info(LABEL, "ignored ranges: {}", colored(GREEN, "{}", config.ignoredRanges().size()));
   for (const auto& range : config.ignoredRanges()) {
     Logger::info(LABEL, "ignored range: {} - {}", formatFrequency(range.first), formatFrequency(range.second));
   }
-  Logger::info(LABEL, "scan ranges: {}", colored(GREEN, "{}", device.m_ranges.size()));
-  for (const auto& range : device.m_ranges) {
-    Logger::info(LABEL, "scan range: {} - {}", formatFrequency(range.first), formatFrequency(range.second));
-  }
   Logger::info(LABEL, "sample rate: {}, split sample rate: {}", formatFrequency(device.m_sampleRate), formatFrequency(getRangeSplitSampleRate(device.m_sampleRate)));
-  Logger::info(LABEL, "splitted scan ranges: {}", colored(GREEN, "{}", m_ranges.size()));
-  for (const auto& range : m_ranges) {
-    Logger::info(LABEL, "splitted scan range: {} - {}", formatFrequency(range.first), formatFrequency(range.second));
-  }
   Logger::info(LABEL, "started");
 }
 
@@ -33,31 +42,85 @@ Scanner::~Scanner() {
   m_thread.join();
 }
 
-void Scanner::worker() {
-  Logger::info(LABEL, "thread started");
+void Scanner::update(const ScanSettings& settings) {
+  Logger::info(
+      LABEL,
+      "update settings, start level: {}, stop level: {}, recorders: {}, scan ranges: {}, ignored ranges: {}",
+      colored(GREEN, "{}", settings.m_startLevel),
+      colored(GREEN, "{}", settings.m_stopLevel),
+      colored(GREEN, "{}", settings.m_recordersCount),
+      colored(GREEN, "{}", settings.m_ranges.size()),
+      colored(GREEN, "{}", settings.m_ignoredRanges.size()));
+  m_settings.store(std::make_shared<const ScanSettings>(settings));
+}
+
+void Scanner::updateRanges(const std::vector<FrequencyRange>& ranges) {
+  Logger::info(LABEL, "scan ranges: {}", colored(GREEN, "{}", ranges.size()));
+  for (const auto& range : ranges) {
+    Logger::info(LABEL, "scan range: {} - {}", formatFrequency(range.first), formatFrequency(range.second));
+  }
+  m_ranges = splitRanges(ranges, getRangeSplitSampleRate(m_sampleRate));
+  m_scheduler.emplace(m_ranges.size(), m_minDwell, m_maxDwell, m_minRevisit, m_maxRevisit);
+  Logger::info(LABEL, "splitted scan ranges: {}", colored(GREEN, "{}", m_ranges.size()));
+  for (const auto& range : m_ranges) {
+    Logger::info(LABEL, "splitted scan range: {} - {}", formatFrequency(range.first), formatFrequency(range.second));
+  }
   if (m_ranges.empty()) {
     Logger::warn(LABEL, "empty scanned ranges");
   } else if (m_ranges.size() == 1) {
     m_device.setFrequencyRange(m_ranges.front());
-    while (m_isRunning) {
-      m_device.updateRecordings(m_notification.wait());
+  }
+}
+
+void Scanner::worker() {
+  Logger::info(LABEL, "thread started");
+  std::shared_ptr<const ScanSettings> settings;
+  while (m_isRunning) {
+    const auto next = m_settings.load();
+    if (!settings || next->m_ranges != settings->m_ranges) {
+      updateRanges(next->m_ranges);
     }
-  } else {
-    while (m_isRunning) {
-      for (const auto& range : m_ranges) {
-        m_device.setFrequencyRange(range);
+    settings = next;
 
-        const auto startScanningTime = getTime();
-        bool isRecording = true;
-        while ((getTime() <= startScanningTime + RANGE_SCANNING_TIME || isRecording) && m_isRunning) {
-          const auto notification = m_notification.wait();
-          isRecording = !notification.empty();
-          m_device.updateRecordings(notification);
-        }
-        if (!m_isRunning) {
+    if (m_ranges.empty()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    } else if (m_ranges.size() == 1) {
+      const auto notification = m_notification.wait(SCANNER_WAIT_TIMEOUT);
+      if (notification) {
+        m_device.updateRecordings(*notification);
+      } else {
+        Logger::warn(LABEL, "no detection frames in {}", colored(RED, "{} ms", SCANNER_WAIT_TIMEOUT.count()));
+      }
+    } else {
+      const auto index = m_scheduler->next(getTime());
+      const auto& range = m_ranges[index];
+      m_device.setFrequencyRange(range);
+
+      const auto startScanningTime = getTime();
+      const auto dwellTime = m_scheduler->getDwellTime(index, startScanningTime);
+      LOG_DEBUG(LABEL, "scan range: {} - {}, dwell: {}", formatFrequency(range.first), formatFrequency(range.second), colored(GREEN, "{} ms", dwellTime.count()));
+      auto lastTime = startScanningTime;
+      auto busyTime = std::chrono::milliseconds(0);
+      bool isDetected = false;
+      bool isRecording = true;
+      while ((getTime() <= startScanningTime + dwellTime || isRecording) && m_isRunning) {
+        const auto notification = m_notification.wait(SCANNER_WAIT_TIMEOUT);
+        if (!notification) {
+          Logger::warn(LABEL, "no detection frames in {}, range: {} - {}", colored(RED, "{} ms", SCANNER_WAIT_TIMEOUT.count()), formatFrequency(range.first), formatFrequency(range.second));
           break;
         }
+        const auto now = getTime();
+        isRecording = !notification->empty();
+        if (isRecording) {
+          busyTime += now - lastTime;
+          isDetected = true;
+        }
+        lastTime = now;
+        m_device.updateRecordings(*notification);
       }
+      const auto now = getTime();
+      const auto totalTime = std::max(std::chrono::milliseconds(1), now - startScanningTime);
+      m_scheduler->report(index, isDetected, static_cast<double>(busyTime.count()) / totalTime.count(), now);
     }
   }
   Logger::info(LABEL, "thread stopped");
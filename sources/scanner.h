@@ -4,23 +4,36 @@
 #include <network/mqtt.h>
 #include <notification.h>
 #include <radio/sdr_device.h>
+#include <scan_scheduler.h>
+#include <utils/snapshot.h>
 
 #include <atomic>
 #include <memory>
+#include <optional>
 #include <thread>
 
 class Scanner {
  public:
-  Scanner(const Config& config, const Device& device, Mqtt& mqtt, const int recordersCount);
+  Scanner(const Config& config, const Device& device, Mqtt& mqtt, const int recordersCount, std::shared_ptr<Source> source = nullptr);
   ~Scanner();
 
+  void update(const ScanSettings& settings);
+
  private:
   void worker();
+  void updateRanges(const std::vector<FrequencyRange>& ranges);
 
+  const Frequency m_sampleRate;
+  const std::chrono::milliseconds m_minDwell;
+  const std::chrono::milliseconds m_maxDwell;
+  const std::chrono::milliseconds m_minRevisit;
+  const std::chrono::milliseconds m_maxRevisit;
+  Snapshot<ScanSettings> m_settings;
   SdrDevice m_device;
-  const std::vector<FrequencyRange> m_ranges;
+  std::vector<FrequencyRange> m_ranges;
+  std::optional<ScanScheduler> m_scheduler;
 
   std::atomic<bool> m_isRunning;
   std::thread m_thread;
   TransmissionNotification m_notification;
-};
\ No newline at end of file
+};
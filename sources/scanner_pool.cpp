@@ -0,0 +1,73 @@
+#include "scanner_pool.h"
+
+#include <logger.h>
+#include <metrics.h>
+
+#include <set>
+
+constexpr auto LABEL = "pool";
+
+ScannerPool::ScannerPool(Mqtt& mqtt) : m_mqtt(mqtt) {}
+
+ScannerPool::~ScannerPool() {
+  while (!m_entries.empty()) {
+    stop(m_entries.begin()->first);
+  }
+}
+
+void ScannerPool::update(std::shared_ptr<const Config> config) {
+  std::set<std::string> names;
+  for (const auto& device : config->devices()) {
+    const auto name = device.getName();
+    names.insert(name);
+    const auto it = m_entries.find(name);
+    if (!device.m_enabled) {
+      Logger::info(LABEL, "device disabled, skipping: {}", colored(GREEN, "{}", name));
+      stop(name);
+    } else if (device.m_ranges.empty()) {
+      Logger::info(LABEL, "empty ranges to scan, skipping: {}", colored(GREEN, "{}", name));
+      stop(name);
+    } else if (it == m_entries.end()) {
+      start(config, device);
+    } else if (Config::isRebuildRequired(it->second.m_device, device) || it->second.m_recordersCount < config->recordersCount()) {
+      Logger::info(LABEL, "device changed, restarting: {}", colored(GREEN, "{}", name));
+      stop(name);
+      start(config, device);
+    } else {
+      Logger::info(LABEL, "device running, updating: {}", colored(GREEN, "{}", name));
+      it->second.m_scanner->update(config->scanSettings(device));
+    }
+  }
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    const auto name = (it++)->first;
+    if (names.count(name) == 0) {
+      Logger::info(LABEL, "device removed: {}", colored(GREEN, "{}", name));
+      stop(name);
+    }
+  }
+  if (m_entries.empty()) {
+    Logger::warn(LABEL, "{}", colored(RED, "{}", "empty devices list"));
+  }
+}
+
+int ScannerPool::size() const { return m_entries.size(); }
+
+void ScannerPool::start(std::shared_ptr<const Config> config, const Device& device) {
+  try {
+    // scanner keeps references to config it was created with
+    auto scanner = std::make_unique<Scanner>(*config, device, m_mqtt, config->recordersCount());
+    m_entries.emplace(device.getName(), Entry{config, device, config->recordersCount(), std::move(scanner)});
+  } catch (const std::exception& exception) {
+    Logger::error(LABEL, "can not open device: {}, exception: {}", colored(RED, "{}", device.getName()), exception.what());
+  }
+}
+
+void ScannerPool::stop(const std::string& name) {
+  const auto it = m_entries.find(name);
+  if (it != m_entries.end()) {
+    it->second.m_scanner.reset();
+    m_entries.erase(it);
+    // stopped device gauges would keep reporting last values
+    Metrics::removeGauges(fmt::format("device=\"{}\"", name));
+  }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <config.h>
+#include <network/mqtt.h>
+#include <scanner.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+// running scanners per device, new config is applied to running devices and only changed hardware is reopened
+class ScannerPool {
+  struct Entry {
+    std::shared_ptr<const Config> m_config;
+    Device m_device;
+    int m_recordersCount;
+    std::unique_ptr<Scanner> m_scanner;
+  };
+
+ public:
+  ScannerPool(Mqtt& mqtt);
+  ~ScannerPool();
+
+  void update(std::shared_ptr<const Config> config);
+  int size() const;
+
+ private:
+  void start(std::shared_ptr<const Config> config, const Device& device);
+  void stop(const std::string& name);
+
+  Mqtt& m_mqtt;
+  std::map<std::string, Entry> m_entries;
+};
@@ -1,8 +1,10 @@
 #include "radio_utils.h"
 
 #include <logger.h>
+#include <utils/simd_utils.h>
 #include <utils/utils.h>
 
+#include <cstring>
 #include <numeric>
 
 namespace {
@@ -83,6 +85,104 @@ std::string getRawFileName(const char* label, const char* extension, Frequency f
   return buf;
 }
 
+std::optional<RawFileInfo> parseRawFileName(const std::string& path) {
+  const auto begin = path.find_last_of('/') == std::string::npos ? 0 : path.find_last_of('/') + 1;
+  const auto end = path.rfind(".raw");
+  if (end == std::string::npos || end < begin) {
+    return std::nullopt;
+  }
+  std::vector<std::string> parts;
+  for (auto i = begin; i <= end;) {
+    const auto next = std::min(path.find('_', i), end);
+    parts.push_back(path.substr(i, next - i));
+    i = next + 1;
+  }
+  if (parts.size() < 5) {
+    return std::nullopt;
+  }
+  try {
+    const auto& format = parts[parts.size() - 1];
+    const auto sampleRate = std::stoi(parts[parts.size() - 2]);
+    const auto frequency = std::stoi(parts[parts.size() - 3]);
+    if (sampleRate <= 0 || frequency <= 0 || (format != "fc" && format != "cs16" && format != "cs8")) {
+      return std::nullopt;
+    }
+    return RawFileInfo{frequency, sampleRate, format};
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
+std::optional<SampleFormat> parseSampleFormat(const std::string& name) {
+  if (name == "cf32" || name == "fc") {
+    return SampleFormat::CF32;
+  } else if (name == "cs16") {
+    return SampleFormat::CS16;
+  } else if (name == "cs8") {
+    return SampleFormat::CS8;
+  } else {
+    return std::nullopt;
+  }
+}
+
+std::string getSampleFormatName(const SampleFormat format) {
+  switch (format) {
+    case SampleFormat::CS16:
+      return "cs16";
+    case SampleFormat::CS8:
+      return "cs8";
+    default:
+      return "cf32";
+  }
+}
+
+const char* getRawFileFormat(const SampleFormat format) {
+  switch (format) {
+    case SampleFormat::CS16:
+      return "cs16";
+    case SampleFormat::CS8:
+      return "cs8";
+    default:
+      return "fc";
+  }
+}
+
+int getSampleSize(const SampleFormat format) {
+  switch (format) {
+    case SampleFormat::CS16:
+      return 2 * sizeof(int16_t);
+    case SampleFormat::CS8:
+      return 2 * sizeof(int8_t);
+    default:
+      return sizeof(std::complex<float>);
+  }
+}
+
+float getSampleScale(const SampleFormat format) {
+  switch (format) {
+    case SampleFormat::CS16:
+      return 1.0f / 32768.0f;
+    case SampleFormat::CS8:
+      return 1.0f / 128.0f;
+    default:
+      return 1.0f;
+  }
+}
+
+void toComplex(const void* input, std::complex<float>* output, const int size, const SampleFormat format, const float scale) {
+  switch (format) {
+    case SampleFormat::CS16:
+      int16ToFloat(static_cast<const int16_t*>(input), reinterpret_cast<float*>(output), 2 * size, scale);
+      break;
+    case SampleFormat::CS8:
+      int8ToFloat(static_cast<const int8_t*>(input), reinterpret_cast<float*>(output), 2 * size, scale);
+      break;
+    default:
+      std::memcpy(output, input, sizeof(std::complex<float>) * size);
+      break;
+  }
+}
+
 Frequency getTunedFrequency(Frequency frequency, Frequency step) {
   const auto rest = frequency < 0 ? frequency % step + step : frequency % step;
   const auto down = frequency - rest;
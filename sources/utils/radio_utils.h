@@ -2,6 +2,14 @@
 
 #include <radio/help_structures.h>
 
+#include <optional>
+
+struct RawFileInfo {
+  Frequency m_frequency;
+  Frequency m_sampleRate;
+  std::string m_format;
+};
+
 std::string formatFrequency(const Frequency frequency, const char* color = nullptr);
 
 std::string formatPower(const float power, const char* color = nullptr);
@@ -10,6 +18,20 @@ void setNoData(float* data, const int size);
 
 std::string getRawFileName(const char* label, const char* extension, Frequency frequency, Frequency sampleRate);
 
+std::optional<RawFileInfo> parseRawFileName(const std::string& path);
+
+std::optional<SampleFormat> parseSampleFormat(const std::string& name);
+
+std::string getSampleFormatName(const SampleFormat format);
+
+const char* getRawFileFormat(const SampleFormat format);
+
+int getSampleSize(const SampleFormat format);
+
+float getSampleScale(const SampleFormat format);
+
+void toComplex(const void* input, std::complex<float>* output, const int size, const SampleFormat format, const float scale);
+
 Frequency getTunedFrequency(Frequency frequency, Frequency step);
 
 int getFft(const Frequency sampleRate, Frequency maxStep);
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+// single producer, single consumer ring of fixed size items, producer never blocks
+// consumer gets contiguous spans pointing directly into the ring
+template <typename T>
+class RingBuffer {
+  static constexpr auto NONE = std::numeric_limits<uint64_t>::max();
+
+ public:
+  enum class Policy { DropNewest, Overwrite };
+
+  RingBuffer(const int itemSize, const int capacity, const Policy policy)
+      : m_itemSize(itemSize), m_capacity(capacity), m_policy(policy), m_data(itemSize * capacity), m_times(capacity), m_head(0), m_tail(0), m_writing(0), m_reading(NONE), m_dropped(0), m_overwritten(0) {}
+
+  RingBuffer(const RingBuffer&) = delete;
+  RingBuffer& operator=(const RingBuffer&) = delete;
+
+  // producer
+  int push(const T* data, const int count, const std::chrono::milliseconds time) {
+    if (m_capacity == 0) {
+      m_dropped.fetch_add(count, std::memory_order_relaxed);
+      return 0;
+    }
+    return m_policy == Policy::DropNewest ? pushDropNewest(data, count, time) : pushOverwrite(data, count, time);
+  }
+
+  // consumer, callback(const T* data, int count, const std::chrono::milliseconds* times) for every contiguous span
+  template <typename F>
+  int pop(F&& callback) {
+    auto tail = m_tail.load(std::memory_order_relaxed);
+    int popped = 0;
+    while (true) {
+      const auto head = m_head.load(std::memory_order_acquire);
+      if (tail == head) {
+        break;
+      }
+      if (m_policy == Policy::Overwrite) {
+        m_reading.store(tail, std::memory_order_seq_cst);
+        const auto writing = m_writing.load(std::memory_order_seq_cst);
+        if (tail + m_capacity <= writing) {
+          const auto next = writing - m_capacity + 1;
+          m_overwritten.fetch_add(next - tail, std::memory_order_relaxed);
+          tail = next;
+          continue;
+        }
+      }
+      const auto index = tail % m_capacity;
+      const auto count = static_cast<int>(std::min(head - tail, m_capacity - index));
+      callback(m_data.data() + index * m_itemSize, count, m_times.data() + index);
+      tail += count;
+      popped += count;
+      m_tail.store(tail, std::memory_order_release);
+    }
+    m_reading.store(NONE, std::memory_order_seq_cst);
+    return popped;
+  }
+
+  // consumer
+  void clear() {
+    const auto head = m_head.load(std::memory_order_acquire);
+    m_tail.store(head, std::memory_order_release);
+  }
+
+  int size() const {
+    const auto head = m_head.load(std::memory_order_acquire);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    return static_cast<int>(std::min(head - std::min(head, tail), m_capacity));
+  }
+
+  int capacity() const { return m_capacity; }
+  uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+  uint64_t overwritten() const { return m_overwritten.load(std::memory_order_relaxed); }
+
+ private:
+  int pushDropNewest(const T* data, const int count, const std::chrono::milliseconds time) {
+    const auto head = m_head.load(std::memory_order_relaxed);
+    const auto tail = m_tail.load(std::memory_order_acquire);
+    const auto stored = static_cast<int>(std::min<uint64_t>(count, m_capacity - (head - tail)));
+    for (int i = 0; i < stored;) {
+      const auto index = (head + i) % m_capacity;
+      const auto size = static_cast<int>(std::min<uint64_t>(stored - i, m_capacity - index));
+      std::memcpy(m_data.data() + index * m_itemSize, data + i * m_itemSize, sizeof(T) * m_itemSize * size);
+      std::fill(m_times.begin() + index, m_times.begin() + index + size, time);
+      i += size;
+    }
+    m_head.store(head + stored, std::memory_order_release);
+    m_dropped.fetch_add(count - stored, std::memory_order_relaxed);
+    return stored;
+  }
+
+  int pushOverwrite(const T* data, const int count, const std::chrono::milliseconds time) {
+    auto head = m_head.load(std::memory_order_relaxed);
+    int stored = 0;
+    for (int i = 0; i < count; ++i) {
+      // claim slot first, then check that consumer is not reading it, consumer does the same in reverse order
+      m_writing.store(head, std::memory_order_seq_cst);
+      const auto reading = m_reading.load(std::memory_order_seq_cst);
+      if (reading != NONE && reading + m_capacity <= head) {
+        m_dropped.fetch_add(count - i, std::memory_order_relaxed);
+        break;
+      }
+      const auto index = head % m_capacity;
+      std::memcpy(m_data.data() + index * m_itemSize, data + i * m_itemSize, sizeof(T) * m_itemSize);
+      m_times[index] = time;
+      m_head.store(++head, std::memory_order_release);
+      stored++;
+    }
+    return stored;
+  }
+
+  const int m_itemSize;
+  const uint64_t m_capacity;
+  const Policy m_policy;
+  std::vector<T> m_data;
+  std::vector<std::chrono::milliseconds> m_times;
+  alignas(64) std::atomic<uint64_t> m_head;
+  alignas(64) std::atomic<uint64_t> m_tail;
+  alignas(64) std::atomic<uint64_t> m_writing;
+  alignas(64) std::atomic<uint64_t> m_reading;
+  alignas(64) std::atomic<uint64_t> m_dropped;
+  std::atomic<uint64_t> m_overwritten;
+};
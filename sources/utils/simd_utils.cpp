@@ -0,0 +1,536 @@
+#include "simd_utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#define SIMD_X86
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SIMD_NEON
+#endif
+
+namespace {
+// minimax fit of log2(1 + t) / t on [0, 1)
+constexpr float LOG2_C0 = 1.441965699e+00f;
+constexpr float LOG2_C1 = -7.096632719e-01f;
+constexpr float LOG2_C2 = 4.175975025e-01f;
+constexpr float LOG2_C3 = -1.962720156e-01f;
+constexpr float LOG2_C4 = 4.638647661e-02f;
+constexpr float DECIBELS_PER_LOG2 = 3.010299957f;  // 10 * log10(2)
+constexpr uint32_t MANTISSA_MASK = 0x007fffff;
+constexpr uint32_t EXPONENT_ONE = 0x3f800000;
+
+float fastLog2(const float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const auto exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+  const uint32_t mantissaBits = (bits & MANTISSA_MASK) | EXPONENT_ONE;
+  float mantissa;
+  std::memcpy(&mantissa, &mantissaBits, sizeof(mantissa));
+  const auto t = mantissa - 1.0f;
+  return exponent + t * (LOG2_C0 + t * (LOG2_C1 + t * (LOG2_C2 + t * (LOG2_C3 + t * LOG2_C4))));
+}
+
+void powerToDecibelsScalar(const std::complex<float>* input, float* output, const int begin, const int size, const float offset) {
+  for (int i = begin; i < size; ++i) {
+    output[i] = DECIBELS_PER_LOG2 * fastLog2(std::norm(input[i])) + offset;
+  }
+}
+
+int addIndexes(uint32_t bits, const int offset, int* indexes, int count) {
+  while (bits) {
+    indexes[count++] = offset + __builtin_ctz(bits);
+    bits &= bits - 1;
+  }
+  return count;
+}
+
+int getIndexesAboveThresholdScalar(const float* data, const uint8_t* mask, const int begin, const int size, const float threshold, int* indexes, int count) {
+  for (int i = begin; i < size; ++i) {
+    if ((mask[i / 8] & (1 << (i % 8))) && threshold <= data[i]) {
+      indexes[count++] = i;
+    }
+  }
+  return count;
+}
+
+void replaceRowScalar(float* sum, float* row, const float* data, const int begin, const int size) {
+  for (int i = begin; i < size; ++i) {
+    sum[i] = sum[i] - row[i] + data[i];
+    row[i] = data[i];
+  }
+}
+
+void divideScalar(const float* data, float* output, const int begin, const int size, const float divisor) {
+  for (int i = begin; i < size; ++i) {
+    output[i] = data[i] / divisor;
+  }
+}
+
+void trackQuantileScalar(float* estimate, const float* data, const int begin, const int size, const float stepUp, const float stepDown) {
+  for (int i = begin; i < size; ++i) {
+    estimate[i] += data[i] < estimate[i] ? -stepDown : stepUp;
+  }
+}
+
+template <typename T>
+void toFloatScalar(const T* input, float* output, const int begin, const int size, const float scale) {
+  for (int i = begin; i < size; ++i) {
+    output[i] = input[i] * scale;
+  }
+}
+
+void floatToInt8Scalar(const float* input, int8_t* output, const int begin, const int size, const float scale) {
+  for (int i = begin; i < size; ++i) {
+    output[i] = static_cast<int8_t>(std::lrint(std::clamp(input[i] * scale, -128.0f, 127.0f)));
+  }
+}
+
+void copyXorScalar(const uint8_t* input, uint8_t* output, const int begin, const int size, const uint8_t value) {
+  for (int i = begin; i < size; ++i) {
+    output[i] = input[i] ^ value;
+  }
+}
+
+#ifdef SIMD_X86
+__attribute__((target("avx2,fma"))) int powerToDecibelsAvx2(const std::complex<float>* input, float* output, const int size, const float offset) {
+  const float* in = reinterpret_cast<const float*>(input);
+  const auto mantissaMask = _mm256_set1_epi32(MANTISSA_MASK);
+  const auto exponentOne = _mm256_set1_epi32(EXPONENT_ONE);
+  const auto bias = _mm256_set1_epi32(127);
+  const auto one = _mm256_set1_ps(1.0f);
+  const auto scale = _mm256_set1_ps(DECIBELS_PER_LOG2);
+  const auto shift = _mm256_set1_ps(offset);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const auto a = _mm256_loadu_ps(in + 2 * i);
+    const auto b = _mm256_loadu_ps(in + 2 * i + 8);
+    const auto sum = _mm256_hadd_ps(_mm256_mul_ps(a, a), _mm256_mul_ps(b, b));
+    const auto power = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(sum), 0xd8));
+    const auto bits = _mm256_castps_si256(power);
+    const auto exponent = _mm256_cvtepi32_ps(_mm256_sub_epi32(_mm256_srli_epi32(bits, 23), bias));
+    const auto t = _mm256_sub_ps(_mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, mantissaMask), exponentOne)), one);
+    auto p = _mm256_set1_ps(LOG2_C4);
+    p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(LOG2_C3));
+    p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(LOG2_C2));
+    p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(LOG2_C1));
+    p = _mm256_fmadd_ps(p, t, _mm256_set1_ps(LOG2_C0));
+    const auto log2 = _mm256_fmadd_ps(p, t, exponent);
+    _mm256_storeu_ps(output + i, _mm256_fmadd_ps(log2, scale, shift));
+  }
+  return i;
+}
+
+int powerToDecibelsSse2(const std::complex<float>* input, float* output, const int size, const float offset) {
+  const float* in = reinterpret_cast<const float*>(input);
+  const auto mantissaMask = _mm_set1_epi32(MANTISSA_MASK);
+  const auto exponentOne = _mm_set1_epi32(EXPONENT_ONE);
+  const auto bias = _mm_set1_epi32(127);
+  const auto one = _mm_set1_ps(1.0f);
+  const auto scale = _mm_set1_ps(DECIBELS_PER_LOG2);
+  const auto shift = _mm_set1_ps(offset);
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto a = _mm_loadu_ps(in + 2 * i);
+    const auto b = _mm_loadu_ps(in + 2 * i + 4);
+    const auto a2 = _mm_mul_ps(a, a);
+    const auto b2 = _mm_mul_ps(b, b);
+    const auto power = _mm_add_ps(_mm_shuffle_ps(a2, b2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(a2, b2, _MM_SHUFFLE(3, 1, 3, 1)));
+    const auto bits = _mm_castps_si128(power);
+    const auto exponent = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), bias));
+    const auto t = _mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, mantissaMask), exponentOne)), one);
+    auto p = _mm_set1_ps(LOG2_C4);
+    p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(LOG2_C3));
+    p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(LOG2_C2));
+    p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(LOG2_C1));
+    p = _mm_add_ps(_mm_mul_ps(p, t), _mm_set1_ps(LOG2_C0));
+    const auto log2 = _mm_add_ps(_mm_mul_ps(p, t), exponent);
+    _mm_storeu_ps(output + i, _mm_add_ps(_mm_mul_ps(log2, scale), shift));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) int getIndexesAboveThresholdAvx2(const float* data, const uint8_t* mask, const int size, const float threshold, int* indexes, int& count) {
+  const auto limit = _mm256_set1_ps(threshold);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    if (mask[i / 8]) {
+      const auto bits = static_cast<uint32_t>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(data + i), limit, _CMP_GE_OQ))) & mask[i / 8];
+      count = addIndexes(bits, i, indexes, count);
+    }
+  }
+  return i;
+}
+
+int getIndexesAboveThresholdSse2(const float* data, const uint8_t* mask, const int size, const float threshold, int* indexes, int& count) {
+  const auto limit = _mm_set1_ps(threshold);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    if (mask[i / 8]) {
+      const auto low = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(data + i), limit)));
+      const auto high = static_cast<uint32_t>(_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(data + i + 4), limit)));
+      count = addIndexes((low | (high << 4)) & mask[i / 8], i, indexes, count);
+    }
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) int replaceRowAvx2(float* sum, float* row, const float* data, const int size) {
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const auto value = _mm256_loadu_ps(data + i);
+    _mm256_storeu_ps(sum + i, _mm256_add_ps(_mm256_sub_ps(_mm256_loadu_ps(sum + i), _mm256_loadu_ps(row + i)), value));
+    _mm256_storeu_ps(row + i, value);
+  }
+  return i;
+}
+
+int replaceRowSse2(float* sum, float* row, const float* data, const int size) {
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto value = _mm_loadu_ps(data + i);
+    _mm_storeu_ps(sum + i, _mm_add_ps(_mm_sub_ps(_mm_loadu_ps(sum + i), _mm_loadu_ps(row + i)), value));
+    _mm_storeu_ps(row + i, value);
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) int divideAvx2(const float* data, float* output, const int size, const float divisor) {
+  const auto value = _mm256_set1_ps(divisor);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    _mm256_storeu_ps(output + i, _mm256_div_ps(_mm256_loadu_ps(data + i), value));
+  }
+  return i;
+}
+
+int divideSse2(const float* data, float* output, const int size, const float divisor) {
+  const auto value = _mm_set1_ps(divisor);
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    _mm_storeu_ps(output + i, _mm_div_ps(_mm_loadu_ps(data + i), value));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) int trackQuantileAvx2(float* estimate, const float* data, const int size, const float stepUp, const float stepDown) {
+  const auto up = _mm256_set1_ps(stepUp);
+  const auto down = _mm256_set1_ps(-stepDown);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const auto value = _mm256_loadu_ps(estimate + i);
+    const auto isBelow = _mm256_cmp_ps(_mm256_loadu_ps(data + i), value, _CMP_LT_OQ);
+    _mm256_storeu_ps(estimate + i, _mm256_add_ps(value, _mm256_blendv_ps(up, down, isBelow)));
+  }
+  return i;
+}
+
+int trackQuantileSse2(float* estimate, const float* data, const int size, const float stepUp, const float stepDown) {
+  const auto up = _mm_set1_ps(stepUp);
+  const auto down = _mm_set1_ps(-stepDown);
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto value = _mm_loadu_ps(estimate + i);
+    const auto isBelow = _mm_cmplt_ps(_mm_loadu_ps(data + i), value);
+    _mm_storeu_ps(estimate + i, _mm_add_ps(value, _mm_or_ps(_mm_and_ps(isBelow, down), _mm_andnot_ps(isBelow, up))));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) int int8ToFloatAvx2(const int8_t* input, float* output, const int size, const float scale) {
+  const auto factor = _mm256_set1_ps(scale);
+  int i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    _mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(value)), factor));
+    _mm256_storeu_ps(output + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_srli_si128(value, 8))), factor));
+  }
+  return i;
+}
+
+int int8ToFloatSse2(const int8_t* input, float* output, const int size, const float scale) {
+  const auto factor = _mm_set1_ps(scale);
+  int i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    // sign extension by duplicating into upper half and arithmetic shift
+    const auto low = _mm_srai_epi16(_mm_unpacklo_epi8(value, value), 8);
+    const auto high = _mm_srai_epi16(_mm_unpackhi_epi8(value, value), 8);
+    _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(low, low), 16)), factor));
+    _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(low, low), 16)), factor));
+    _mm_storeu_ps(output + i + 8, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(high, high), 16)), factor));
+    _mm_storeu_ps(output + i + 12, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(high, high), 16)), factor));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) int int16ToFloatAvx2(const int16_t* input, float* output, const int size, const float scale) {
+  const auto factor = _mm256_set1_ps(scale);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    _mm256_storeu_ps(output + i, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(value)), factor));
+  }
+  return i;
+}
+
+int int16ToFloatSse2(const int16_t* input, float* output, const int size, const float scale) {
+  const auto factor = _mm_set1_ps(scale);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+    _mm_storeu_ps(output + i, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16)), factor));
+    _mm_storeu_ps(output + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16)), factor));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) int floatToInt8Avx2(const float* input, int8_t* output, const int size, const float scale) {
+  const auto factor = _mm256_set1_ps(scale);
+  const auto min = _mm256_set1_ps(-128.0f);
+  const auto max = _mm256_set1_ps(127.0f);
+  int i = 0;
+  for (; i + 16 <= size; i += 16) {
+    // clamp before conversion, out of range floats convert to INT32_MIN
+    const auto a = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(input + i), factor), min), max));
+    const auto b = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(input + i + 8), factor), min), max));
+    const auto packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(a, b), 0xd8);
+    const auto value = _mm_packs_epi16(_mm256_castsi256_si128(packed), _mm256_extracti128_si256(packed, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), value);
+  }
+  return i;
+}
+
+int floatToInt8Sse2(const float* input, int8_t* output, const int size, const float scale) {
+  const auto factor = _mm_set1_ps(scale);
+  const auto min = _mm_set1_ps(-128.0f);
+  const auto max = _mm_set1_ps(127.0f);
+  const auto convert = [&](const int offset) { return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(input + offset), factor), min), max)); };
+  int i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const auto low = _mm_packs_epi32(convert(i), convert(i + 4));
+    const auto high = _mm_packs_epi32(convert(i + 8), convert(i + 12));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi16(low, high));
+  }
+  return i;
+}
+
+__attribute__((target("avx2"))) int copyXorAvx2(const uint8_t* input, uint8_t* output, const int size, const uint8_t value) {
+  const auto mask = _mm256_set1_epi8(static_cast<char>(value));
+  int i = 0;
+  for (; i + 32 <= size; i += 32) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i)), mask));
+  }
+  return i;
+}
+
+int copyXorSse2(const uint8_t* input, uint8_t* output, const int size, const uint8_t value) {
+  const auto mask = _mm_set1_epi8(static_cast<char>(value));
+  int i = 0;
+  for (; i + 16 <= size; i += 16) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i)), mask));
+  }
+  return i;
+}
+
+bool isAvx2Supported() {
+  static const bool isSupported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  return isSupported;
+}
+#endif
+
+#ifdef SIMD_NEON
+int powerToDecibelsNeon(const std::complex<float>* input, float* output, const int size, const float offset) {
+  const float* in = reinterpret_cast<const float*>(input);
+  const auto mantissaMask = vdupq_n_u32(MANTISSA_MASK);
+  const auto exponentOne = vdupq_n_u32(EXPONENT_ONE);
+  const auto bias = vdupq_n_s32(127);
+  const auto one = vdupq_n_f32(1.0f);
+  const auto scale = vdupq_n_f32(DECIBELS_PER_LOG2);
+  const auto shift = vdupq_n_f32(offset);
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto iq = vld2q_f32(in + 2 * i);
+    const auto power = vmlaq_f32(vmulq_f32(iq.val[0], iq.val[0]), iq.val[1], iq.val[1]);
+    const auto bits = vreinterpretq_u32_f32(power);
+    const auto exponent = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), bias));
+    const auto t = vsubq_f32(vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, mantissaMask), exponentOne)), one);
+    auto p = vdupq_n_f32(LOG2_C4);
+    p = vmlaq_f32(vdupq_n_f32(LOG2_C3), p, t);
+    p = vmlaq_f32(vdupq_n_f32(LOG2_C2), p, t);
+    p = vmlaq_f32(vdupq_n_f32(LOG2_C1), p, t);
+    p = vmlaq_f32(vdupq_n_f32(LOG2_C0), p, t);
+    const auto log2 = vmlaq_f32(exponent, p, t);
+    vst1q_f32(output + i, vmlaq_f32(shift, log2, scale));
+  }
+  return i;
+}
+
+uint32_t getNeonBits(const uint32x4_t value) {
+  const uint32_t weights[4] = {1, 2, 4, 8};
+  const auto bits = vandq_u32(value, vld1q_u32(weights));
+  return vgetq_lane_u32(bits, 0) | vgetq_lane_u32(bits, 1) | vgetq_lane_u32(bits, 2) | vgetq_lane_u32(bits, 3);
+}
+
+int getIndexesAboveThresholdNeon(const float* data, const uint8_t* mask, const int size, const float threshold, int* indexes, int& count) {
+  const auto limit = vdupq_n_f32(threshold);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    if (mask[i / 8]) {
+      const auto low = getNeonBits(vcgeq_f32(vld1q_f32(data + i), limit));
+      const auto high = getNeonBits(vcgeq_f32(vld1q_f32(data + i + 4), limit));
+      count = addIndexes((low | (high << 4)) & mask[i / 8], i, indexes, count);
+    }
+  }
+  return i;
+}
+
+int replaceRowNeon(float* sum, float* row, const float* data, const int size) {
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto value = vld1q_f32(data + i);
+    vst1q_f32(sum + i, vaddq_f32(vsubq_f32(vld1q_f32(sum + i), vld1q_f32(row + i)), value));
+    vst1q_f32(row + i, value);
+  }
+  return i;
+}
+
+int trackQuantileNeon(float* estimate, const float* data, const int size, const float stepUp, const float stepDown) {
+  const auto up = vdupq_n_f32(stepUp);
+  const auto down = vdupq_n_f32(-stepDown);
+  int i = 0;
+  for (; i + 4 <= size; i += 4) {
+    const auto value = vld1q_f32(estimate + i);
+    const auto isBelow = vcltq_f32(vld1q_f32(data + i), value);
+    vst1q_f32(estimate + i, vaddq_f32(value, vbslq_f32(isBelow, down, up)));
+  }
+  return i;
+}
+
+int int8ToFloatNeon(const int8_t* input, float* output, const int size, const float scale) {
+  const auto factor = vdupq_n_f32(scale);
+  int i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const auto value = vld1q_s8(input + i);
+    const auto low = vmovl_s8(vget_low_s8(value));
+    const auto high = vmovl_s8(vget_high_s8(value));
+    vst1q_f32(output + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(low))), factor));
+    vst1q_f32(output + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(low))), factor));
+    vst1q_f32(output + i + 8, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(high))), factor));
+    vst1q_f32(output + i + 12, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(high))), factor));
+  }
+  return i;
+}
+
+int int16ToFloatNeon(const int16_t* input, float* output, const int size, const float scale) {
+  const auto factor = vdupq_n_f32(scale);
+  int i = 0;
+  for (; i + 8 <= size; i += 8) {
+    const auto value = vld1q_s16(input + i);
+    vst1q_f32(output + i, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(value))), factor));
+    vst1q_f32(output + i + 4, vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(value))), factor));
+  }
+  return i;
+}
+
+int copyXorNeon(const uint8_t* input, uint8_t* output, const int size, const uint8_t value) {
+  const auto mask = vdupq_n_u8(value);
+  int i = 0;
+  for (; i + 16 <= size; i += 16) {
+    vst1q_u8(output + i, veorq_u8(vld1q_u8(input + i), mask));
+  }
+  return i;
+}
+#endif
+}  // namespace
+
+void powerToDecibels(const std::complex<float>* input, float* output, const int size, const float offset) {
+  int i = 0;
+#if defined(SIMD_X86)
+  i = isAvx2Supported() ? powerToDecibelsAvx2(input, output, size, offset) : powerToDecibelsSse2(input, output, size, offset);
+#elif defined(SIMD_NEON)
+  i = powerToDecibelsNeon(input, output, size, offset);
+#endif
+  powerToDecibelsScalar(input, output, i, size, offset);
+}
+
+int getIndexesAboveThreshold(const float* data, const uint8_t* mask, const int size, const float threshold, int* indexes) {
+  int i = 0;
+  int count = 0;
+#if defined(SIMD_X86)
+  i = isAvx2Supported() ? getIndexesAboveThresholdAvx2(data, mask, size, threshold, indexes, count) : getIndexesAboveThresholdSse2(data, mask, size, threshold, indexes, count);
+#elif defined(SIMD_NEON)
+  i = getIndexesAboveThresholdNeon(data, mask, size, threshold, indexes, count);
+#endif
+  return getIndexesAboveThresholdScalar(data, mask, i, size, threshold, indexes, count);
+}
+
+void replaceRow(float* sum, float* row, const float* data, const int size) {
+  int i = 0;
+#if defined(SIMD_X86)
+  i = isAvx2Supported() ? replaceRowAvx2(sum, row, data, size) : replaceRowSse2(sum, row, data, size);
+#elif defined(SIMD_NEON)
+  i = replaceRowNeon(sum, row, data, size);
+#endif
+  replaceRowScalar(sum, row, data, i, size);
+}
+
+void divide(const float* data, float* output, const int size, const float divisor) {
+  int i = 0;
+#if defined(SIMD_X86)
+  i = isAvx2Supported() ? divideAvx2(data, output, size, divisor) : divideSse2(data, output, size, divisor);
+#endif
+  divideScalar(data, output, i, size, divisor);
+}
+
+void trackQuantile(float* estimate, const float* data, const int size, const float stepUp, const float stepDown) {
+  int i = 0;
+#if defined(SIMD_X86)
+  i = isAvx2Supported() ? trackQuantileAvx2(estimate, data, size, stepUp, stepDown) : trackQuantileSse2(estimate, data, size, stepUp, stepDown);
+#elif defined(SIMD_NEON)
+  i = trackQuantileNeon(estimate, data, size, stepUp, stepDown);
+#endif
+  trackQuantileScalar(estimate, data, i, size, stepUp, stepDown);
+}
+
+void int8ToFloat(const int8_t* input, float* output, const int size, const float scale) {
+  int i = 0;
+#if defined(SIMD_X86)
+  i = isAvx2Supported() ? int8ToFloatAvx2(input, output, size, scale) : int8ToFloatSse2(input, output, size, scale);
+#elif defined(SIMD_NEON)
+  i = int8ToFloatNeon(input, output, size, scale);
+#endif
+  toFloatScalar(input, output, i, size, scale);
+}
+
+void int16ToFloat(const int16_t* input, float* output, const int size, const float scale) {
+  int i = 0;
+#if defined(SIMD_X86)
+  i = isAvx2Supported() ? int16ToFloatAvx2(input, output, size, scale) : int16ToFloatSse2(input, output, size, scale);
+#elif defined(SIMD_NEON)
+  i = int16ToFloatNeon(input, output, size, scale);
+#endif
+  toFloatScalar(input, output, i, size, scale);
+}
+
+void floatToInt8(const float* input, int8_t* output, const int size, const float scale) {
+  int i = 0;
+#if defined(SIMD_X86)
+  i = isAvx2Supported() ? floatToInt8Avx2(input, output, size, scale) : floatToInt8Sse2(input, output, size, scale);
+#endif
+  floatToInt8Scalar(input, output, i, size, scale);
+}
+
+void copyXor(const uint8_t* input, uint8_t* output, const int size, const uint8_t value) {
+  int i = 0;
+#if defined(SIMD_X86)
+  i = isAvx2Supported() ? copyXorAvx2(input, output, size, value) : copyXorSse2(input, output, size, value);
+#elif defined(SIMD_NEON)
+  i = copyXorNeon(input, output, size, value);
+#endif
+  copyXorScalar(input, output, i, size, value);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <complex>
+#include <cstdint>
+
+// 10 * log10(|x|^2) + offset, fast log2 approximation, absolute error below 0.0001 dB
+void powerToDecibels(const std::complex<float>* input, float* output, const int size, const float offset);
+
+// indexes of values greater or equal threshold with bit set in mask (bit i % 8 of byte i / 8), returns count
+int getIndexesAboveThreshold(const float* data, const uint8_t* mask, const int size, const float threshold, int* indexes);
+
+// sum = sum - row + data, then row = data
+void replaceRow(float* sum, float* row, const float* data, const int size);
+
+// output = data / divisor
+void divide(const float* data, float* output, const int size, const float divisor);
+
+// estimate += data < estimate ? -stepDown : stepUp, settles where stepUp / (stepUp + stepDown) of data is below estimate
+void trackQuantile(float* estimate, const float* data, const int size, const float stepUp, const float stepDown);
+
+// output = input * scale, interleaved iq values
+void int8ToFloat(const int8_t* input, float* output, const int size, const float scale);
+
+// output = input * scale, interleaved iq values
+void int16ToFloat(const int16_t* input, float* output, const int size, const float scale);
+
+// output = round(input * scale) saturated to int8 range, interleaved iq values
+void floatToInt8(const float* input, int8_t* output, const int size, const float scale);
+
+// output = input ^ value, e.g. signed to offset binary with 0x80
+void copyXor(const uint8_t* input, uint8_t* output, const int size, const uint8_t value);
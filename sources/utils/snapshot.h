@@ -0,0 +1,20 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+// immutable value shared between threads, writer swaps whole value, readers keep loaded value alive while using it
+template <typename T>
+class Snapshot {
+ public:
+  Snapshot(std::shared_ptr<const T> value) : m_value(std::move(value)) {}
+
+  Snapshot(const Snapshot&) = delete;
+  Snapshot& operator=(const Snapshot&) = delete;
+
+  std::shared_ptr<const T> load() const { return std::atomic_load_explicit(&m_value, std::memory_order_acquire); }
+  void store(std::shared_ptr<const T> value) { std::atomic_store_explicit(&m_value, std::move(value), std::memory_order_release); }
+
+ private:
+  std::shared_ptr<const T> m_value;
+};
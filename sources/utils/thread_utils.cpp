@@ -0,0 +1,38 @@
+#include "thread_utils.h"
+
+#include <sched.h>
+#include <sys/mman.h>
+
+bool setThreadAffinity(pthread_t thread, const std::vector<int>& cores) {
+  if (cores.empty()) {
+    return true;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const auto core : cores) {
+    if (core < 0 || CPU_SETSIZE <= core) {
+      return false;
+    }
+    CPU_SET(core, &set);
+  }
+  return pthread_setaffinity_np(thread, sizeof(set), &set) == 0;
+}
+
+bool setThreadRealTimePriority(pthread_t thread, const int priority) {
+  sched_param param{};
+  param.sched_priority = priority;
+  return pthread_setschedparam(thread, 0 < priority ? SCHED_FIFO : SCHED_OTHER, &param) == 0;
+}
+
+bool lockMemory() { return mlockall(MCL_CURRENT | MCL_FUTURE) == 0; }
+
+std::string formatCores(const std::vector<int>& cores) {
+  if (cores.empty()) {
+    return "any";
+  }
+  std::string result;
+  for (const auto core : cores) {
+    result += (result.empty() ? "" : ",") + std::to_string(core);
+  }
+  return result;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <pthread.h>
+
+#include <string>
+#include <vector>
+
+// empty cores list keeps thread floating over all cores
+bool setThreadAffinity(pthread_t thread, const std::vector<int>& cores);
+
+// SCHED_FIFO with given priority, 0 restores SCHED_OTHER
+bool setThreadRealTimePriority(pthread_t thread, const int priority);
+
+// lock current and future pages in memory, needs CAP_IPC_LOCK or high RLIMIT_MEMLOCK
+bool lockMemory();
+
+std::string formatCores(const std::vector<int>& cores);
@@ -0,0 +1,152 @@
+#include "waterfall_codec.h"
+
+#include <cstring>
+
+namespace {
+constexpr uint8_t KEYFRAME = 0;
+constexpr uint8_t DELTA = 1;
+constexpr uint32_t ESCAPE = 16;
+constexpr int RAW_BITS = 9;
+constexpr int MAX_RICE_PARAMETER = 8;
+
+uint32_t zigzag(const int value) { return value < 0 ? -2 * value - 1 : 2 * value; }
+
+int unzigzag(const uint32_t value) { return value & 1 ? -static_cast<int>((value + 1) / 2) : static_cast<int>(value / 2); }
+
+class BitWriter {
+ public:
+  BitWriter(std::string& data) : m_data(data), m_buffer(0), m_bits(0) {}
+
+  void write(const uint32_t value, const int bits) {
+    for (int i = bits - 1; 0 <= i; --i) {
+      m_buffer = (m_buffer << 1) | ((value >> i) & 1);
+      if (++m_bits == 8) {
+        m_data.push_back(static_cast<char>(m_buffer));
+        m_buffer = 0;
+        m_bits = 0;
+      }
+    }
+  }
+
+  void flush() {
+    if (m_bits) {
+      write(0, 8 - m_bits);
+    }
+  }
+
+ private:
+  std::string& m_data;
+  uint32_t m_buffer;
+  int m_bits;
+};
+
+class BitReader {
+ public:
+  BitReader(const uint8_t* data, const int size) : m_data(data), m_size(size), m_position(0) {}
+
+  bool read(uint32_t& value, const int bits) {
+    value = 0;
+    for (int i = 0; i < bits; ++i) {
+      if (8 * m_size <= m_position) {
+        return false;
+      }
+      value = (value << 1) | ((m_data[m_position / 8] >> (7 - m_position % 8)) & 1);
+      m_position++;
+    }
+    return true;
+  }
+
+ private:
+  const uint8_t* m_data;
+  const int m_size;
+  int m_position;
+};
+
+int getRiceParameter(const std::vector<uint32_t>& residuals) {
+  uint64_t sum = 0;
+  for (const auto value : residuals) {
+    sum += value;
+  }
+  int k = 0;
+  while (k < MAX_RICE_PARAMETER && (static_cast<uint64_t>(residuals.size()) << (k + 1)) <= sum) {
+    k++;
+  }
+  return k;
+}
+}  // namespace
+
+WaterfallEncoder::WaterfallEncoder(const int size, const int keyframeInterval)
+    : m_size(size), m_keyframeInterval(keyframeInterval), m_previous(size, 0), m_residuals(size, 0), m_frames(0) {}
+
+std::string WaterfallEncoder::encode(const int8_t* row) {
+  const auto type = m_frames % m_keyframeInterval == 0 ? KEYFRAME : DELTA;
+  for (int i = 0; i < m_size; ++i) {
+    const auto reference = type == KEYFRAME ? (i == 0 ? 0 : row[i - 1]) : m_previous[i];
+    m_residuals[i] = zigzag(row[i] - reference);
+  }
+  const auto k = getRiceParameter(m_residuals);
+
+  std::string data;
+  data.reserve(2 + m_size);
+  data.push_back(static_cast<char>(type));
+  data.push_back(static_cast<char>(k));
+  BitWriter writer(data);
+  for (const auto value : m_residuals) {
+    const auto quotient = value >> k;
+    if (quotient < ESCAPE) {
+      writer.write((1u << (quotient + 1)) - 2, quotient + 1);
+      writer.write(value, k);
+    } else {
+      writer.write((1u << ESCAPE) - 1, ESCAPE);
+      writer.write(value, RAW_BITS);
+    }
+  }
+  writer.flush();
+
+  std::memcpy(m_previous.data(), row, m_size);
+  m_frames++;
+  return data;
+}
+
+void WaterfallEncoder::reset() { m_frames = 0; }
+
+WaterfallDecoder::WaterfallDecoder(const int size) : m_size(size), m_previous(size, 0), m_hasKeyframe(false) {}
+
+bool WaterfallDecoder::decode(const uint8_t* data, const int size, int8_t* row) {
+  if (size < 2 || MAX_RICE_PARAMETER < data[1]) {
+    return false;
+  }
+  const auto type = data[0];
+  const int k = data[1];
+  if (type != KEYFRAME && (type != DELTA || !m_hasKeyframe)) {
+    return false;
+  }
+  BitReader reader(data + 2, size - 2);
+  for (int i = 0; i < m_size; ++i) {
+    uint32_t quotient = 0;
+    uint32_t bit = 1;
+    while (quotient < ESCAPE) {
+      if (!reader.read(bit, 1)) {
+        return false;
+      }
+      if (!bit) {
+        break;
+      }
+      quotient++;
+    }
+    uint32_t value = 0;
+    if (quotient < ESCAPE) {
+      if (!reader.read(value, k)) {
+        return false;
+      }
+      value |= quotient << k;
+    } else if (!reader.read(value, RAW_BITS)) {
+      return false;
+    }
+    const auto reference = type == KEYFRAME ? (i == 0 ? 0 : row[i - 1]) : m_previous[i];
+    row[i] = static_cast<int8_t>(reference + unzigzag(value));
+  }
+  std::memcpy(m_previous.data(), row, m_size);
+  m_hasKeyframe = true;
+  return true;
+}
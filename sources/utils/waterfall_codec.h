@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// live waterfall rows, keyframes are coded against previous bin, other rows against previous row
+// residuals are zigzag mapped and rice coded with per row parameter
+// row layout: type (uint8), rice parameter (uint8), bitstream (msb first)
+class WaterfallEncoder {
+ public:
+  WaterfallEncoder(const int size, const int keyframeInterval);
+
+  std::string encode(const int8_t* row);
+  void reset();
+
+ private:
+  const int m_size;
+  const int m_keyframeInterval;
+  std::vector<int8_t> m_previous;
+  std::vector<uint32_t> m_residuals;
+  int m_frames;
+};
+
+class WaterfallDecoder {
+ public:
+  WaterfallDecoder(const int size);
+
+  bool decode(const uint8_t* data, const int size, int8_t* row);
+
+ private:
+  const int m_size;
+  std::vector<int8_t> m_previous;
+  bool m_hasKeyframe;
+};
@@ -9,6 +9,13 @@ constexpr auto GROUP_SIZE = 3;
 
 std::vector<float> generate(const float value) { return std::vector<float>(SIZE, value); }
 std::deque<std::vector<float>> generateRaw(const float v1, const float v2, const float v3) { return {generate(v1), generate(v2), generate(v3)}; }
+std::deque<std::vector<float>> getRows(const Averager& averager) {
+  std::deque<std::vector<float>> rows;
+  for (int i = 0; i < averager.rows(); ++i) {
+    rows.emplace_back(averager.row(i), averager.row(i) + SIZE);
+  }
+  return rows;
+}
 
 class AveragerTest : public testing::Test {
  public:
@@ -46,33 +53,33 @@ class AveragerTest : public testing::Test {
 TEST_F(AveragerTest, SimpleTest) {
   add({1, 2, 3, 4, 5});
   EXPECT_EQ(m_averager.average(), generate(-100));
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(getRows(m_averager), m_rawData);
 
   add({2, 3, 4, 5, 6});
   EXPECT_EQ(m_averager.average(), generate(-100));
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(getRows(m_averager), m_rawData);
 
   add({3, 4, 5, 6, 7});
   EXPECT_EQ(m_averager.average(), average());
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(getRows(m_averager), m_rawData);
 
   add({6, 7, 8, 9, 10});
   EXPECT_EQ(m_averager.average(), average());
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(getRows(m_averager), m_rawData);
 
   add({7, 8, 9, 10, 11});
   EXPECT_EQ(m_averager.average(), average());
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(getRows(m_averager), m_rawData);
 }
 
 TEST_F(AveragerTest, SimpleBigTest) {
   add({1, 2, 3, 4, 5});
   EXPECT_EQ(m_averager.average(), generate(-100));
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(getRows(m_averager), m_rawData);
 
   add({2, 3, 4, 5, 6});
   EXPECT_EQ(m_averager.average(), generate(-100));
-  EXPECT_EQ(m_averager.data(), m_rawData);
+  EXPECT_EQ(getRows(m_averager), m_rawData);
 
   for (int i = 1; i < 123; ++i) {
     std::vector<float> data;
@@ -81,7 +88,24 @@ TEST_F(AveragerTest, SimpleBigTest) {
     }
     add(data);
     EXPECT_EQ(m_averager.average(), average());
-    EXPECT_EQ(m_averager.data(), m_rawData);
+    EXPECT_EQ(getRows(m_averager), m_rawData);
+  }
+}
+
+TEST_F(AveragerTest, NoDriftAfterManyFrames) {
+  // large values leave rounding residue in running sum after they leave the window
+  for (int i = 0; i < 100000; ++i) {
+    const auto value = i % 7 == 0 ? 1000000.0f + i : (i % 100) * 0.1f;
+    add(generate(value));
+  }
+  // residue is dropped once sum is recomputed
+  for (int i = 0; i < 1000; ++i) {
+    add(generate(0.1f * (i % 3)));
+  }
+  const auto expected = average();
+  const auto& result = m_averager.average();
+  for (int j = 0; j < SIZE; ++j) {
+    EXPECT_NEAR(result[j], expected[j], 1e-5f);
   }
 }
 
@@ -92,49 +116,49 @@ TEST(Averager, SimpleTest) {
   Averager avg(size, 3);
 
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 0, 0));
+  EXPECT_EQ(getRows(avg), generateRaw(0, 0, 0));
 
   avg.push(generate(1).data());
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 0, 1));
+  EXPECT_EQ(getRows(avg), generateRaw(0, 0, 1));
 
   avg.push(generate(2).data());
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 1, 2));
+  EXPECT_EQ(getRows(avg), generateRaw(0, 1, 2));
 
   avg.push(generate(3).data());
   EXPECT_EQ(avg.average(), generate(2));
-  EXPECT_EQ(avg.data(), generateRaw(1, 2, 3));
+  EXPECT_EQ(getRows(avg), generateRaw(1, 2, 3));
 
   avg.push(generate(10).data());
   EXPECT_EQ(avg.average(), generate(5));
-  EXPECT_EQ(avg.data(), generateRaw(2, 3, 10));
+  EXPECT_EQ(getRows(avg), generateRaw(2, 3, 10));
 
   avg.push(generate(11).data());
   EXPECT_EQ(avg.average(), generate(8));
-  EXPECT_EQ(avg.data(), generateRaw(3, 10, 11));
+  EXPECT_EQ(getRows(avg), generateRaw(3, 10, 11));
 
   avg.reset();
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 0, 0));
+  EXPECT_EQ(getRows(avg), generateRaw(0, 0, 0));
 
   avg.push(generate(1).data());
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 0, 1));
+  EXPECT_EQ(getRows(avg), generateRaw(0, 0, 1));
 
   avg.push(generate(2).data());
   EXPECT_EQ(avg.average(), generate(-100));
-  EXPECT_EQ(avg.data(), generateRaw(0, 1, 2));
+  EXPECT_EQ(getRows(avg), generateRaw(0, 1, 2));
 
   avg.push(generate(3).data());
   EXPECT_EQ(avg.average(), generate(2));
-  EXPECT_EQ(avg.data(), generateRaw(1, 2, 3));
+  EXPECT_EQ(getRows(avg), generateRaw(1, 2, 3));
 
   avg.push(generate(10).data());
   EXPECT_EQ(avg.average(), generate(5));
-  EXPECT_EQ(avg.data(), generateRaw(2, 3, 10));
+  EXPECT_EQ(getRows(avg), generateRaw(2, 3, 10));
 
   avg.push(generate(11).data());
   EXPECT_EQ(avg.average(), generate(8));
-  EXPECT_EQ(avg.data(), generateRaw(3, 10, 11));
+  EXPECT_EQ(getRows(avg), generateRaw(3, 10, 11));
 }
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <radio/bin_table.h>
+
+TEST(BinTable, Frequencies) {
+  const BinTable table(8, 8000, {100000, 108000}, {});
+  EXPECT_EQ(table.shift(0), -3500);
+  EXPECT_EQ(table.shift(7), 3500);
+  EXPECT_EQ(table.frequency(0), 100500);
+  EXPECT_EQ(table.frequency(7), 107500);
+}
+
+TEST(BinTable, Range) {
+  const BinTable table(16, 16000, {102000, 110000}, {});
+  for (int i = 0; i < 16; ++i) {
+    const auto frequency = table.frequency(i);
+    EXPECT_EQ(table.isAllowed(i), 102000 <= frequency && frequency <= 110000) << "index: " << i;
+  }
+  EXPECT_EQ(table.mask()[0], 0xf0);
+  EXPECT_EQ(table.mask()[1], 0x0f);
+}
+
+TEST(BinTable, IgnoredRanges) {
+  const std::vector<FrequencyRange> ignoredRanges{{101000, 102000}, {104500, 104500}, {200000, 300000}};
+  const BinTable table(16, 16000, {98000, 114000}, ignoredRanges);
+  for (int i = 0; i < 16; ++i) {
+    const auto frequency = table.frequency(i);
+    bool isIgnored = false;
+    for (const auto& [first, second] : ignoredRanges) {
+      isIgnored |= first <= frequency && frequency <= second;
+    }
+    EXPECT_EQ(table.isAllowed(i), !isIgnored) << "index: " << i;
+  }
+  EXPECT_FALSE(table.isAllowed(6));
+  EXPECT_FALSE(table.isAllowed(3));
+  EXPECT_TRUE(table.isAllowed(4));
+}
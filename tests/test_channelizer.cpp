@@ -0,0 +1,123 @@
+#include <config.h>
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <radio/blocks/channelizer.h>
+#include <radio/blocks/source.h>
+
+using namespace std::chrono_literals;
+
+constexpr auto SAMPLE_RATE = 1024000;
+constexpr auto BANDWIDTH = 32000;
+constexpr auto SHIFT = 100000;
+constexpr auto TONE_OFFSET = 1234;
+constexpr auto SAMPLES = 768000;
+constexpr auto PRE_TRIGGER = 50ms;
+constexpr auto PRE_TRIGGER_SAMPLES = BANDWIDTH * PRE_TRIGGER.count() / 1000;
+constexpr auto SETTLE_SAMPLES = SAMPLE_RATE * RETUNE_SETTLE_TIME.count() / 1000;
+
+// channel 0 is extracted live from first sample, channel 1 is started when trigger sample is reached
+class TriggeredChannelizer : public Channelizer {
+ public:
+  TriggeredChannelizer(const uint64_t trigger)
+      : gr::block("TriggeredChannelizer", gr::io_signature::make(1, 1, sizeof(gr_complex)), gr::io_signature::make(2, 2, sizeof(gr_complex))),
+        Channelizer(SAMPLE_RATE, BANDWIDTH, 2, SampleFormat::CF32, 1.0f, false, PRE_TRIGGER),
+        m_trigger(trigger),
+        m_isTriggered(false),
+        m_triggered(0),
+        m_backfill(0) {
+    startChannel(0, SHIFT);
+  }
+
+  int general_work(int noutput_items, gr_vector_int& ninput_items, gr_vector_const_void_star& input_items, gr_vector_void_star& output_items) override {
+    if (!m_isTriggered && m_trigger <= nitems_read(0)) {
+      m_isTriggered = true;
+      m_triggered = nitems_read(0);
+      m_backfill = startChannel(1, SHIFT);
+    }
+    return Channelizer::general_work(noutput_items, ninput_items, input_items, output_items);
+  }
+
+  const uint64_t m_trigger;
+  bool m_isTriggered;
+  uint64_t m_triggered;
+  std::chrono::milliseconds m_backfill;
+};
+
+class ChannelizerTest : public testing::Test {
+ public:
+  void run(const uint64_t trigger, const std::vector<gr::tag_t>& tags) {
+    std::vector<gr_complex> samples(SAMPLES);
+    for (int i = 0; i < SAMPLES; ++i) {
+      samples[i] = std::polar(0.5f, static_cast<float>(2.0 * M_PI * (SHIFT + TONE_OFFSET) * i / SAMPLE_RATE));
+    }
+    m_channelizer = std::make_shared<TriggeredChannelizer>(trigger);
+    auto tb = gr::make_top_block("test");
+    auto source = gr::blocks::vector_source_c::make(samples, false, 1, tags);
+    auto live = gr::blocks::vector_sink_c::make();
+    auto triggered = gr::blocks::vector_sink_c::make();
+    tb->connect(source, 0, m_channelizer, 0);
+    tb->connect(m_channelizer, 0, live, 0);
+    tb->connect(m_channelizer, 1, triggered, 0);
+    tb->run();
+    m_live = live->data();
+    m_triggered = triggered->data();
+  }
+
+  // index of first triggered channel sample in live channel output
+  int getOffset() const { return static_cast<int>(m_live.size() - m_triggered.size()); }
+
+  void expectEqualToLive() const {
+    const auto offset = getOffset();
+    float error = 0.0f;
+    for (size_t i = 0; i < m_triggered.size(); ++i) {
+      error = std::max(error, std::abs(m_triggered[i] - m_live[offset + i]));
+    }
+    EXPECT_LT(error, 1e-5f);
+    EXPECT_NEAR(std::abs(m_triggered[m_triggered.size() / 2]), 0.5f, 0.05f);
+  }
+
+  std::shared_ptr<TriggeredChannelizer> m_channelizer;
+  std::vector<gr_complex> m_live;
+  std::vector<gr_complex> m_triggered;
+};
+
+TEST_F(ChannelizerTest, BackfillMatchesLive) {
+  // history ring holds about 1.5 pre trigger, trigger is reached after it wrapped several times
+  run(400000, {});
+  ASSERT_TRUE(m_channelizer->m_isTriggered);
+  ASSERT_FALSE(m_triggered.empty());
+
+  const auto decimation = m_channelizer->getDecimation();
+  const auto backfilled = static_cast<int>(m_channelizer->m_triggered / decimation) - getOffset();
+  EXPECT_GE(backfilled, PRE_TRIGGER_SAMPLES);
+  EXPECT_LE(backfilled, 2 * PRE_TRIGGER_SAMPLES);
+  EXPECT_NEAR(m_channelizer->m_backfill.count(), backfilled * 1000 / BANDWIDTH, 1);
+  expectEqualToLive();
+}
+
+TEST_F(ChannelizerTest, BackfillStopsAtRetune) {
+  // samples before retune and settle window belong to previous frequency
+  constexpr uint64_t RETUNE = 370000;
+  run(400000, {{RETUNE, pmt::string_to_symbol(RETUNE_TAG), pmt::from_uint64(1), pmt::PMT_F}});
+  ASSERT_TRUE(m_channelizer->m_isTriggered);
+  ASSERT_FALSE(m_triggered.empty());
+
+  const auto decimation = m_channelizer->getDecimation();
+  const auto firstSample = static_cast<uint64_t>(getOffset()) * decimation;
+  EXPECT_GE(firstSample, RETUNE + SETTLE_SAMPLES);
+  EXPECT_LT(firstSample, m_channelizer->m_triggered);
+  EXPECT_LT(m_channelizer->m_triggered - firstSample, static_cast<uint64_t>(PRE_TRIGGER_SAMPLES * decimation));
+  expectEqualToLive();
+}
+
+TEST_F(ChannelizerTest, WithoutPreTriggerHistory) {
+  // channel started before any block was processed has nothing to backfill
+  run(0, {});
+  ASSERT_TRUE(m_channelizer->m_isTriggered);
+  ASSERT_FALSE(m_triggered.empty());
+  EXPECT_EQ(getOffset(), 0);
+  EXPECT_EQ(m_channelizer->m_backfill.count(), 0);
+  expectEqualToLive();
+}
@@ -0,0 +1,79 @@
+#include <gnuradio/blocks/vector_sink.h>
+#include <gnuradio/blocks/vector_source.h>
+#include <gnuradio/top_block.h>
+#include <gtest/gtest.h>
+#include <radio/blocks/frame_selector.h>
+#include <radio/blocks/source.h>
+
+constexpr auto ITEM_SIZE = 16;
+constexpr auto PERIOD = 64;
+constexpr auto SETTLE = 100;
+constexpr auto SAMPLES = 10000;
+
+class FrameSelectorTest : public testing::Test {
+ public:
+  FrameSelectorTest() : m_selector(std::make_shared<FrameSelector>(ITEM_SIZE, PERIOD, SETTLE, false, SampleFormat::CF32, 1.0f, "test")) {}
+
+  gr::tag_t getRetuneTag(const uint64_t offset, const uint64_t sequence) const { return {offset, pmt::string_to_symbol(RETUNE_TAG), pmt::from_uint64(sequence), pmt::PMT_F}; }
+
+  // returns first sample index of every selected frame, input sample value is its index
+  std::vector<int> run(const std::vector<gr::tag_t>& tags) {
+    std::vector<gr_complex> samples(SAMPLES);
+    for (int i = 0; i < SAMPLES; ++i) {
+      samples[i] = gr_complex(i, 0.0f);
+    }
+    auto tb = gr::make_top_block("test");
+    auto source = gr::blocks::vector_source_c::make(samples, false, 1, tags);
+    auto sink = gr::blocks::vector_sink_c::make(ITEM_SIZE);
+    tb->connect(source, 0, m_selector, 0);
+    tb->connect(m_selector, 0, sink, 0);
+    tb->run();
+
+    std::vector<int> frames;
+    const auto data = sink->data();
+    for (size_t i = 0; i < data.size(); i += ITEM_SIZE) {
+      frames.push_back(static_cast<int>(data[i].real()));
+    }
+    return frames;
+  }
+
+  std::shared_ptr<FrameSelector> m_selector;
+};
+
+TEST_F(FrameSelectorTest, WithoutRetune) {
+  const auto frames = run({});
+  ASSERT_EQ(frames.size(), static_cast<size_t>(SAMPLES / PERIOD + 1));
+  EXPECT_EQ(frames[0], 0);
+  EXPECT_EQ(frames[1], PERIOD);
+}
+
+TEST_F(FrameSelectorTest, Retune) {
+  m_selector->waitForRetune(1);
+  const auto frames = run({getRetuneTag(1000, 1)});
+  ASSERT_FALSE(frames.empty());
+  EXPECT_EQ(frames[0], 1000 + SETTLE);
+  EXPECT_EQ(frames[1], 1000 + SETTLE + PERIOD);
+}
+
+TEST_F(FrameSelectorTest, TwoRetunesBackToBack) {
+  m_selector->waitForRetune(1);
+  m_selector->waitForRetune(2);
+  const auto frames = run({getRetuneTag(1000, 1), getRetuneTag(3000, 2)});
+  ASSERT_FALSE(frames.empty());
+  EXPECT_EQ(frames[0], 3000 + SETTLE);
+}
+
+TEST_F(FrameSelectorTest, TwoRetunesSharingTag) {
+  // source tags only last retune if both were applied before next read
+  m_selector->waitForRetune(1);
+  m_selector->waitForRetune(2);
+  const auto frames = run({getRetuneTag(1000, 2)});
+  ASSERT_FALSE(frames.empty());
+  EXPECT_EQ(frames[0], 1000 + SETTLE);
+}
+
+TEST_F(FrameSelectorTest, StaleRetuneTag) {
+  m_selector->waitForRetune(2);
+  const auto frames = run({getRetuneTag(1000, 1)});
+  EXPECT_TRUE(frames.empty());
+}
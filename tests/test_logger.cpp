@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <logger.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+namespace {
+constexpr auto LOG_FILE = "test_logger.log";
+constexpr auto MESSAGES = 10000;
+
+int countLines(const std::string& path) {
+  std::ifstream file(path);
+  std::string line;
+  int count = 0;
+  while (std::getline(file, line)) {
+    count++;
+  }
+  return count;
+}
+
+int logMessages(const LogMode mode, const int queueSize) {
+  std::remove(LOG_FILE);
+  Logger::configure(spdlog::level::off, spdlog::level::info, LOG_FILE, 1024 * 1024 * 1024, 1, false, mode, queueSize, {});
+  const auto dropped = Logger::dropped();
+  for (int i = 0; i < MESSAGES; ++i) {
+    Logger::info("test", "message: {}", i);
+  }
+  // waits for async thread and closes file
+  Logger::configure(spdlog::level::off, spdlog::level::off, "", 0, 0, true, LogMode::Sync, 0, {});
+  EXPECT_EQ(countLines(LOG_FILE) + Logger::dropped() - dropped, MESSAGES);
+  const auto count = countLines(LOG_FILE);
+  std::remove(LOG_FILE);
+  return count;
+}
+}  // namespace
+
+TEST(Logger, Sync) { EXPECT_EQ(logMessages(LogMode::Sync, 0), MESSAGES); }
+
+TEST(Logger, AsyncBlock) { EXPECT_EQ(logMessages(LogMode::AsyncBlock, 16), MESSAGES); }
+
+TEST(Logger, AsyncDropOldest) { EXPECT_LE(logMessages(LogMode::AsyncDropOldest, 16), MESSAGES); }
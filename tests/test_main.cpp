@@ -2,7 +2,7 @@
 #include <logger.h>
 
 int main(int argc, char **argv) {
-  Logger::configure(spdlog::level::off, spdlog::level::off, "", 0, 0, true);
+  Logger::configure(spdlog::level::off, spdlog::level::off, "", 0, 0, true, LogMode::Sync, 0, {});
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <metrics.h>
+
+TEST(Metrics, Format) {
+  Metrics::clear();
+  Metrics::increment("overflows_total{device=\"a\"}");
+  Metrics::increment("overflows_total{device=\"a\"}", 2);
+  Metrics::set("queue_size", 1.5);
+  Metrics::observe("retune_latency_ms{device=\"a\"}", 10);
+  Metrics::observe("retune_latency_ms{device=\"a\"}", 30);
+  Metrics::observe("frame_time_ms", 2);
+
+  EXPECT_EQ(
+      Metrics::format(),
+      "# TYPE frame_time_ms_count counter\n"
+      "frame_time_ms_count 1\n"
+      "# TYPE frame_time_ms_max gauge\n"
+      "frame_time_ms_max 2\n"
+      "# TYPE frame_time_ms_sum counter\n"
+      "frame_time_ms_sum 2\n"
+      "# TYPE overflows_total counter\n"
+      "overflows_total{device=\"a\"} 3\n"
+      "# TYPE queue_size gauge\n"
+      "queue_size 1.5\n"
+      "# TYPE retune_latency_ms_count counter\n"
+      "retune_latency_ms_count{device=\"a\"} 2\n"
+      "# TYPE retune_latency_ms_max gauge\n"
+      "retune_latency_ms_max{device=\"a\"} 30\n"
+      "# TYPE retune_latency_ms_sum counter\n"
+      "retune_latency_ms_sum{device=\"a\"} 40\n");
+
+  Metrics::clear();
+  EXPECT_EQ(Metrics::format(), "");
+}
+
+TEST(Metrics, RemoveGauges) {
+  Metrics::clear();
+  Metrics::increment("overflows_total{device=\"a\"}");
+  Metrics::set("recorders_active{device=\"a\"}", 1);
+  Metrics::set("recorders_active{device=\"ab\"}", 2);
+  Metrics::set("frames{block=\"fft\",device=\"a\"}", 3);
+  Metrics::set("queue_size", 4);
+
+  Metrics::removeGauges("device=\"a\"");
+  EXPECT_EQ(
+      Metrics::format(),
+      "# TYPE overflows_total counter\n"
+      "overflows_total{device=\"a\"} 1\n"
+      "# TYPE queue_size gauge\n"
+      "queue_size 4\n"
+      "# TYPE recorders_active gauge\n"
+      "recorders_active{device=\"ab\"} 2\n");
+  Metrics::clear();
+}
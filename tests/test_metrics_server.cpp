@@ -0,0 +1,42 @@
+#include <arpa/inet.h>
+#include <gtest/gtest.h>
+#include <metrics.h>
+#include <network/metrics_server.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+std::string request(const int port, const std::string& data) {
+  const auto client = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(port);
+  EXPECT_EQ(connect(client, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+  EXPECT_EQ(send(client, data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+  std::string response;
+  char buffer[1024];
+  ssize_t size = 0;
+  while (0 < (size = recv(client, buffer, sizeof(buffer), 0))) {
+    response.append(buffer, size);
+  }
+  close(client);
+  return response;
+}
+
+TEST(MetricsServer, Request) {
+  Metrics::clear();
+  Metrics::increment("samples_read_total{device=\"a\"}", 1024);
+  MetricsServer server("127.0.0.1", 0, {});
+  ASSERT_NE(server.port(), 0);
+
+  const auto metrics = request(server.port(), "GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+  EXPECT_EQ(metrics.rfind("HTTP/1.1 200 OK\r\n", 0), 0);
+  EXPECT_NE(metrics.find("\r\n\r\n# TYPE samples_read_total counter\nsamples_read_total{device=\"a\"} 1024\n"), std::string::npos);
+
+  const auto missing = request(server.port(), "GET / HTTP/1.1\r\n\r\n");
+  EXPECT_EQ(missing.rfind("HTTP/1.1 404 Not Found\r\n", 0), 0);
+  Metrics::clear();
+}
+
+TEST(MetricsServer, InvalidAddress) { EXPECT_THROW(MetricsServer("localhost", 0, {}), std::runtime_error); }
@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+#include <radio/noise_cache.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+using namespace std::chrono_literals;
+
+constexpr auto ITEM_SIZE = 8;
+constexpr auto MAX_AGE = 3600000ms;
+constexpr auto HASH = 1234;
+
+class NoiseCacheTest : public testing::Test {
+ public:
+  NoiseCacheTest() : m_path(testing::TempDir() + "noise_test.cache"), m_now(1700000000000ms) { std::remove(m_path.c_str()); }
+  ~NoiseCacheTest() { std::remove(m_path.c_str()); }
+
+  std::vector<float> getThreshold(const float offset) const {
+    std::vector<float> threshold(ITEM_SIZE);
+    for (int i = 0; i < ITEM_SIZE; ++i) {
+      threshold[i] = offset - i * 1.25f;
+    }
+    return threshold;
+  }
+
+  int getFileSize() const { return std::ifstream(m_path, std::ios::binary | std::ios::ate).tellg(); }
+
+  const std::string m_path;
+  const std::chrono::milliseconds m_now;
+};
+
+TEST_F(NoiseCacheTest, RoundTrip) {
+  {
+    NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+    cache.store(100000000, getThreshold(-40.0f), m_now);
+    cache.store(102000000, getThreshold(-50.0f), m_now);
+  }
+
+  NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+  EXPECT_EQ(cache.size(), 2);
+  std::vector<float> threshold;
+  ASSERT_TRUE(cache.load(100000000, threshold, m_now));
+  const auto expected = getThreshold(-40.0f);
+  for (int i = 0; i < ITEM_SIZE; ++i) {
+    EXPECT_NEAR(threshold[i], expected[i], 0.005f);
+  }
+  EXPECT_FALSE(cache.load(104000000, threshold, m_now));
+}
+
+TEST_F(NoiseCacheTest, LatestEntryWinsAndFileIsCompacted) {
+  {
+    NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+    cache.store(100000000, getThreshold(-40.0f), m_now);
+    cache.store(100000000, getThreshold(-30.0f), m_now + 1000ms);
+  }
+  const auto appendedSize = getFileSize();
+
+  NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+  std::vector<float> threshold;
+  ASSERT_TRUE(cache.load(100000000, threshold, m_now));
+  EXPECT_NEAR(threshold[0], -30.0f, 0.005f);
+  EXPECT_LT(getFileSize(), appendedSize);
+}
+
+TEST_F(NoiseCacheTest, RepeatedStoreKeepsFileBounded) {
+  NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+  cache.store(100000000, getThreshold(-40.0f), m_now);
+  cache.store(102000000, getThreshold(-50.0f), m_now);
+  const auto compactSize = getFileSize();
+  const auto entrySize = (compactSize - 12) / 2;
+
+  for (int i = 0; i < 1000; ++i) {
+    cache.store(100000000, getThreshold(-40.0f + i % 10), m_now + std::chrono::milliseconds(i));
+    EXPECT_LE(getFileSize(), compactSize + 2 * entrySize);
+  }
+  EXPECT_EQ(cache.size(), 2);
+
+  NoiseCache reloaded(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+  std::vector<float> threshold;
+  ASSERT_TRUE(reloaded.load(100000000, threshold, m_now));
+  EXPECT_NEAR(threshold[0], -40.0f + 999 % 10, 0.005f);
+}
+
+TEST_F(NoiseCacheTest, ConfigChangeInvalidates) {
+  {
+    NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+    cache.store(100000000, getThreshold(-40.0f), m_now);
+  }
+  {
+    NoiseCache cache(m_path, HASH + 1, ITEM_SIZE, MAX_AGE, m_now);
+    EXPECT_EQ(cache.size(), 0);
+    cache.store(102000000, getThreshold(-50.0f), m_now);
+  }
+
+  NoiseCache cache(m_path, HASH + 1, ITEM_SIZE, MAX_AGE, m_now);
+  std::vector<float> threshold;
+  EXPECT_FALSE(cache.load(100000000, threshold, m_now));
+  EXPECT_TRUE(cache.load(102000000, threshold, m_now));
+}
+
+TEST_F(NoiseCacheTest, OldEntriesExpire) {
+  NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+  cache.store(100000000, getThreshold(-40.0f), m_now);
+
+  std::vector<float> threshold;
+  EXPECT_TRUE(cache.load(100000000, threshold, m_now + MAX_AGE));
+  EXPECT_FALSE(cache.load(100000000, threshold, m_now + MAX_AGE + 1ms));
+  EXPECT_EQ(NoiseCache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now + MAX_AGE + 1ms).size(), 0);
+}
+
+TEST_F(NoiseCacheTest, CorruptedEntrySize) {
+  {
+    NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+    cache.store(100000000, getThreshold(-40.0f), m_now);
+    cache.store(102000000, getThreshold(-50.0f), m_now);
+  }
+  const auto validSize = getFileSize();
+  {
+    // entry header: frequency, time, item count, followed by few bytes of data
+    std::ofstream file(m_path, std::ios::binary | std::ios::app);
+    const int32_t frequency = 104000000;
+    const int64_t time = m_now.count();
+    const uint32_t size = 0xffffffff;
+    file.write(reinterpret_cast<const char*>(&frequency), sizeof(frequency));
+    file.write(reinterpret_cast<const char*>(&time), sizeof(time));
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write("\x01\x02\x03\x04", 4);
+  }
+
+  NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+  EXPECT_EQ(cache.size(), 2);
+  std::vector<float> threshold;
+  EXPECT_TRUE(cache.load(102000000, threshold, m_now));
+  EXPECT_FALSE(cache.load(104000000, threshold, m_now));
+  EXPECT_EQ(getFileSize(), validSize);
+}
+
+TEST_F(NoiseCacheTest, TruncatedEntry) {
+  {
+    NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+    cache.store(100000000, getThreshold(-40.0f), m_now);
+  }
+  const auto validSize = getFileSize();
+  {
+    NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+    cache.store(102000000, getThreshold(-50.0f), m_now);
+  }
+  std::filesystem::resize_file(m_path, getFileSize() - 3);
+
+  NoiseCache cache(m_path, HASH, ITEM_SIZE, MAX_AGE, m_now);
+  EXPECT_EQ(cache.size(), 1);
+  std::vector<float> threshold;
+  EXPECT_TRUE(cache.load(100000000, threshold, m_now));
+  EXPECT_EQ(getFileSize(), validSize);
+}
+
+TEST(NoiseCache, ConfigHash) {
+  Device device;
+  device.m_driver = "rtlsdr";
+  device.m_serial = "00000001";
+  device.m_sampleRate = 2048000;
+  device.m_gains = {{"TUNER", 40.0f}};
+  const auto hash = NoiseCache::getConfigHash(device, 2048);
+
+  EXPECT_EQ(NoiseCache::getConfigHash(device, 2048), hash);
+  EXPECT_NE(NoiseCache::getConfigHash(device, 4096), hash);
+  device.m_gains = {{"TUNER", 30.0f}};
+  EXPECT_NE(NoiseCache::getConfigHash(device, 2048), hash);
+}
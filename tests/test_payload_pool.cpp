@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include <network/payload_pool.h>
+
+TEST(PayloadPool, ReuseReleasedBuffer) {
+  PayloadPool pool(2);
+  auto first = pool.get(100);
+  EXPECT_EQ(first->size(), 100);
+  const auto data = first->data();
+  EXPECT_EQ(pool.allocated(), 1);
+  EXPECT_EQ(pool.available(), 0);
+
+  first.reset();
+  EXPECT_EQ(pool.available(), 1);
+
+  const auto second = pool.get(50);
+  EXPECT_EQ(second->size(), 50);
+  EXPECT_EQ(second->data(), data);
+  EXPECT_EQ(pool.allocated(), 1);
+  EXPECT_EQ(pool.available(), 0);
+}
+
+TEST(PayloadPool, Capacity) {
+  PayloadPool pool(2);
+  {
+    std::vector<std::shared_ptr<std::string>> buffers;
+    for (int i = 0; i < 4; ++i) {
+      buffers.push_back(pool.get(10));
+    }
+    EXPECT_EQ(pool.allocated(), 4);
+  }
+  EXPECT_EQ(pool.available(), 2);
+  const auto buffer = pool.get(10);
+  EXPECT_EQ(pool.allocated(), 4);
+  EXPECT_EQ(pool.available(), 1);
+}
+
+TEST(PayloadPool, BufferOutlivesPool) {
+  std::shared_ptr<const std::string> buffer;
+  {
+    PayloadPool pool(2);
+    auto payload = pool.get(3);
+    payload->assign("abc");
+    buffer = std::move(payload);
+  }
+  EXPECT_EQ(*buffer, "abc");
+  buffer.reset();
+}
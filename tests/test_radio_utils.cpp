@@ -130,3 +130,49 @@ TEST(RadioUtils, SplitRanges) {
   EXPECT_EQ(splitRange({140000000, 145000000}, 2000000), Ranges({{140000000, 142000000}, {142000000, 144000000}, {144000000, 146000000}}));
   EXPECT_EQ(splitRange({140000000, 150000000}, 2000000), Ranges({{140000000, 142000000}, {142000000, 144000000}, {144000000, 146000000}, {146000000, 148000000}, {148000000, 150000000}}));
 }
+
+TEST(RadioUtils, ParseRawFileName) {
+  const auto full = parseRawFileName("./full_20240101_120000_145000000_2048000_fc.raw");
+  ASSERT_TRUE(full.has_value());
+  EXPECT_EQ(full->m_frequency, 145000000);
+  EXPECT_EQ(full->m_sampleRate, 2048000);
+  EXPECT_EQ(full->m_format, "fc");
+
+  const auto recording = parseRawFileName("/data/captures/my_capture_20240101_120000_433920000_20480000_cs8.raw");
+  ASSERT_TRUE(recording.has_value());
+  EXPECT_EQ(recording->m_frequency, 433920000);
+  EXPECT_EQ(recording->m_sampleRate, 20480000);
+  EXPECT_EQ(recording->m_format, "cs8");
+
+  EXPECT_EQ(parseRawFileName(getRawFileName("full", "cs16", 100000000, 1024000))->m_format, "cs16");
+  EXPECT_FALSE(parseRawFileName("./full_20240101_120000_145000000_2048000_power.raw").has_value());
+  EXPECT_FALSE(parseRawFileName("./full_20240101_120000_abc_2048000_fc.raw").has_value());
+  EXPECT_FALSE(parseRawFileName("./capture.cf32").has_value());
+  EXPECT_FALSE(parseRawFileName("./145000000_2048000_fc.raw").has_value());
+}
+
+TEST(RadioUtils, SampleFormat) {
+  EXPECT_EQ(parseSampleFormat("cf32"), SampleFormat::CF32);
+  EXPECT_EQ(parseSampleFormat("fc"), SampleFormat::CF32);
+  EXPECT_EQ(parseSampleFormat("cs16"), SampleFormat::CS16);
+  EXPECT_EQ(parseSampleFormat("cs8"), SampleFormat::CS8);
+  EXPECT_FALSE(parseSampleFormat("cu8").has_value());
+  for (const auto format : {SampleFormat::CF32, SampleFormat::CS16, SampleFormat::CS8}) {
+    EXPECT_EQ(parseSampleFormat(getSampleFormatName(format)), format);
+    EXPECT_EQ(parseSampleFormat(getRawFileFormat(format)), format);
+  }
+  EXPECT_EQ(getSampleSize(SampleFormat::CF32), 8);
+  EXPECT_EQ(getSampleSize(SampleFormat::CS16), 4);
+  EXPECT_EQ(getSampleSize(SampleFormat::CS8), 2);
+
+  const std::vector<int8_t> cs8 = {-128, 127, 64, -1};
+  const std::vector<int16_t> cs16 = {-32768, 32767, 16384, -1};
+  std::vector<std::complex<float>> output(2);
+  toComplex(cs8.data(), output.data(), 2, SampleFormat::CS8, getSampleScale(SampleFormat::CS8));
+  EXPECT_EQ(output, std::vector<std::complex<float>>({{-1.0f, 127.0f / 128.0f}, {0.5f, -1.0f / 128.0f}}));
+  toComplex(cs16.data(), output.data(), 2, SampleFormat::CS16, getSampleScale(SampleFormat::CS16));
+  EXPECT_EQ(output, std::vector<std::complex<float>>({{-1.0f, 32767.0f / 32768.0f}, {0.5f, -1.0f / 32768.0f}}));
+  const std::vector<std::complex<float>> cf32 = {{0.25f, -0.5f}, {1.0f, 2.0f}};
+  toComplex(cf32.data(), output.data(), 2, SampleFormat::CF32, 1.0f);
+  EXPECT_EQ(output, cf32);
+}
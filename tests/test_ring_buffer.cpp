@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <utils/ring_buffer.h>
+
+#include <thread>
+
+using Policy = RingBuffer<int>::Policy;
+
+std::vector<int> popAll(RingBuffer<int>& ring, const int itemSize, std::vector<int64_t>* times = nullptr) {
+  std::vector<int> result;
+  ring.pop([&](const int* data, const int count, const std::chrono::milliseconds* t) {
+    result.insert(result.end(), data, data + count * itemSize);
+    for (int i = 0; times && i < count; ++i) {
+      times->push_back(t[i].count());
+    }
+  });
+  return result;
+}
+
+TEST(RingBuffer, PushPop) {
+  RingBuffer<int> ring(2, 4, Policy::DropNewest);
+  const std::vector<int> data1{1, 2, 3, 4};
+  const std::vector<int> data2{5, 6};
+  EXPECT_EQ(ring.push(data1.data(), 2, std::chrono::milliseconds(10)), 2);
+  EXPECT_EQ(ring.push(data2.data(), 1, std::chrono::milliseconds(20)), 1);
+  EXPECT_EQ(ring.size(), 3);
+
+  std::vector<int64_t> times;
+  EXPECT_EQ(popAll(ring, 2, &times), std::vector<int>({1, 2, 3, 4, 5, 6}));
+  EXPECT_EQ(times, std::vector<int64_t>({10, 10, 20}));
+  EXPECT_EQ(ring.size(), 0);
+  EXPECT_TRUE(popAll(ring, 2).empty());
+  EXPECT_EQ(ring.dropped(), 0);
+}
+
+TEST(RingBuffer, WrapAroundSpans) {
+  RingBuffer<int> ring(1, 4, Policy::DropNewest);
+  const std::vector<int> data{1, 2, 3, 4, 5, 6};
+  ring.push(data.data(), 3, std::chrono::milliseconds(0));
+  EXPECT_EQ(popAll(ring, 1), std::vector<int>({1, 2, 3}));
+
+  ring.push(data.data() + 3, 3, std::chrono::milliseconds(0));
+  std::vector<int> spans;
+  ring.pop([&spans](const int*, const int count, const std::chrono::milliseconds*) { spans.push_back(count); });
+  EXPECT_EQ(spans, std::vector<int>({1, 2}));
+}
+
+TEST(RingBuffer, DropNewest) {
+  RingBuffer<int> ring(1, 4, Policy::DropNewest);
+  const std::vector<int> data{1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(ring.push(data.data(), 6, std::chrono::milliseconds(0)), 4);
+  EXPECT_EQ(ring.dropped(), 2);
+  EXPECT_EQ(popAll(ring, 1), std::vector<int>({1, 2, 3, 4}));
+}
+
+TEST(RingBuffer, Overwrite) {
+  RingBuffer<int> ring(1, 4, Policy::Overwrite);
+  const std::vector<int> data{1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(ring.push(data.data(), 6, std::chrono::milliseconds(0)), 6);
+  EXPECT_EQ(ring.dropped(), 0);
+  EXPECT_EQ(popAll(ring, 1), std::vector<int>({3, 4, 5, 6}));
+  EXPECT_EQ(ring.overwritten(), 2);
+}
+
+TEST(RingBuffer, OverwriteDoesNotTouchSpanBeingRead) {
+  RingBuffer<int> ring(1, 4, Policy::Overwrite);
+  const std::vector<int> data{1, 2, 3, 4, 5, 6};
+  ring.push(data.data(), 4, std::chrono::milliseconds(0));
+  std::vector<int> result;
+  ring.pop([&](const int* values, const int count, const std::chrono::milliseconds*) {
+    if (result.empty()) {
+      EXPECT_EQ(ring.push(data.data() + 4, 2, std::chrono::milliseconds(0)), 0);
+    }
+    result.insert(result.end(), values, values + count);
+  });
+  EXPECT_EQ(result, std::vector<int>({1, 2, 3, 4}));
+  EXPECT_EQ(ring.dropped(), 2);
+}
+
+TEST(RingBuffer, Clear) {
+  RingBuffer<int> ring(1, 4, Policy::Overwrite);
+  const std::vector<int> data{1, 2, 3};
+  ring.push(data.data(), 3, std::chrono::milliseconds(0));
+  ring.clear();
+  EXPECT_EQ(ring.size(), 0);
+  EXPECT_TRUE(popAll(ring, 1).empty());
+}
+
+TEST(RingBuffer, ZeroCapacity) {
+  RingBuffer<int> ring(1, 0, Policy::DropNewest);
+  const std::vector<int> data{1, 2, 3};
+  EXPECT_EQ(ring.push(data.data(), 3, std::chrono::milliseconds(0)), 0);
+  EXPECT_EQ(ring.dropped(), 3);
+  EXPECT_TRUE(popAll(ring, 1).empty());
+}
+
+void testConcurrent(const Policy policy) {
+  constexpr auto ITEM_SIZE = 64;
+  constexpr auto ITEMS = 200000;
+  RingBuffer<int> ring(ITEM_SIZE, 16, policy);
+  std::atomic_bool isRunning(true);
+  std::thread producer([&]() {
+    std::vector<int> item(ITEM_SIZE);
+    for (int i = 0; i < ITEMS; ++i) {
+      std::fill(item.begin(), item.end(), i);
+      ring.push(item.data(), 1, std::chrono::milliseconds(i));
+    }
+    isRunning = false;
+  });
+
+  int last = -1;
+  uint64_t received = 0;
+  const auto consume = [&](const int* data, const int count, const std::chrono::milliseconds* times) {
+    for (int i = 0; i < count; ++i) {
+      const auto value = data[i * ITEM_SIZE];
+      EXPECT_LT(last, value);
+      EXPECT_EQ(times[i].count(), value);
+      for (int j = 0; j < ITEM_SIZE; ++j) {
+        ASSERT_EQ(data[i * ITEM_SIZE + j], value);
+      }
+      last = value;
+      received++;
+    }
+  };
+  while (isRunning) {
+    ring.pop(consume);
+  }
+  producer.join();
+  ring.pop(consume);
+  EXPECT_EQ(received + ring.dropped() + ring.overwritten(), ITEMS);
+}
+
+TEST(RingBuffer, ConcurrentDropNewest) { testConcurrent(Policy::DropNewest); }
+
+TEST(RingBuffer, ConcurrentOverwrite) { testConcurrent(Policy::Overwrite); }
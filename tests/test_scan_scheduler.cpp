@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <scan_scheduler.h>
+
+#include <map>
+
+using namespace std::chrono_literals;
+
+constexpr auto MIN_DWELL = 500ms;
+constexpr auto MAX_DWELL = 2000ms;
+constexpr auto MIN_REVISIT = 1000ms;
+constexpr auto MAX_REVISIT = 10000ms;
+
+class ScanSchedulerTest : public testing::Test {
+ public:
+  ScanSchedulerTest() : m_scheduler(4, MIN_DWELL, MAX_DWELL, MIN_REVISIT, MAX_REVISIT), m_now(100000ms) {}
+
+  int visit(const std::map<int, double>& occupancy) {
+    const auto index = m_scheduler.next(m_now);
+    m_now += m_scheduler.getDwellTime(index, m_now);
+    const auto it = occupancy.find(index);
+    const auto value = it == occupancy.end() ? 0.0 : it->second;
+    m_scheduler.report(index, 0.0 < value, value, m_now);
+    return index;
+  }
+
+  ScanScheduler m_scheduler;
+  std::chrono::milliseconds m_now;
+};
+
+TEST_F(ScanSchedulerTest, InitialSweep) {
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(m_scheduler.getDwellTime(i, m_now), MIN_DWELL);
+    EXPECT_EQ(visit({}), i);
+  }
+}
+
+TEST_F(ScanSchedulerTest, QuietRangesRoundRobin) {
+  std::vector<int> visits;
+  for (int i = 0; i < 12; ++i) {
+    visits.push_back(visit({}));
+  }
+  EXPECT_EQ(visits, std::vector<int>({0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3}));
+}
+
+TEST_F(ScanSchedulerTest, BusyRangePreferred) {
+  std::map<int, int> visits;
+  std::map<int, std::chrono::milliseconds> lastVisits;
+  std::chrono::milliseconds maxGap(0);
+  for (int i = 0; i < 200; ++i) {
+    const auto index = visit({{2, 0.5}});
+    if (lastVisits.count(index)) {
+      maxGap = std::max(maxGap, m_now - lastVisits[index]);
+    }
+    lastVisits[index] = m_now;
+    visits[index]++;
+  }
+  EXPECT_GT(visits[2], visits[0]);
+  EXPECT_LT(MIN_DWELL, m_scheduler.getDwellTime(2, m_now));
+  EXPECT_EQ(m_scheduler.getDwellTime(0, m_now), MIN_DWELL);
+  EXPECT_LE(maxGap, MAX_REVISIT + MAX_DWELL);
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_LT(0, visits[i]);
+  }
+}
+
+TEST_F(ScanSchedulerTest, MaxRevisitGuarantee) {
+  for (int i = 0; i < 4; ++i) {
+    visit({});
+  }
+  m_scheduler.report(3, true, 1.0, m_now);
+  m_now += MAX_REVISIT;
+  EXPECT_EQ(m_scheduler.next(m_now), 0);
+}
+
+TEST_F(ScanSchedulerTest, ActivityDecays) {
+  for (int i = 0; i < 4; ++i) {
+    visit({{1, 1.0}});
+  }
+  EXPECT_EQ(m_scheduler.getDwellTime(1, m_now), MAX_DWELL);
+  for (int i = 0; i < 40; ++i) {
+    visit({});
+  }
+  m_now += std::chrono::hours(1);
+  EXPECT_LT(m_scheduler.getDwellTime(1, m_now), MIN_DWELL + (MAX_DWELL - MIN_DWELL) / 10);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <utils/simd_utils.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+constexpr auto SAMPLE_RATE = 20480000;
+constexpr auto DECIBELS_TOLERANCE = 0.0001f;
+
+std::vector<std::complex<float>> generateRandom(const int size) {
+  std::mt19937 generator(size);
+  std::uniform_real_distribution<float> phase(0.0f, 2.0f * M_PI);
+  std::uniform_real_distribution<float> exponent(-12.0f, 6.0f);
+  std::vector<std::complex<float>> data;
+  for (int i = 0; i < size; ++i) {
+    data.push_back(std::polar(std::pow(10.0f, exponent(generator)), phase(generator)));
+  }
+  return data;
+}
+
+void expectPowerToDecibels(const std::vector<std::complex<float>>& input) {
+  std::vector<float> output(input.size());
+  powerToDecibels(input.data(), output.data(), input.size(), -10.0f * std::log10(static_cast<float>(SAMPLE_RATE)));
+  for (size_t i = 0; i < input.size(); ++i) {
+    const auto expected = 10.0f * std::log10(std::pow(std::abs(input[i]), 2.0f) / SAMPLE_RATE);
+    EXPECT_NEAR(output[i], expected, DECIBELS_TOLERANCE + std::abs(expected) * 1e-6f) << "index: " << i << ", value: " << input[i];
+  }
+}
+
+TEST(SimdUtils, PowerToDecibelsRandom) { expectPowerToDecibels(generateRandom(131072)); }
+
+TEST(SimdUtils, PowerToDecibelsTail) {
+  for (int size = 1; size < 40; ++size) {
+    expectPowerToDecibels(generateRandom(size));
+  }
+}
+
+TEST(SimdUtils, PowerToDecibelsExactPowers) {
+  std::vector<std::complex<float>> input;
+  for (int i = -20; i <= 20; ++i) {
+    input.emplace_back(std::pow(2.0f, static_cast<float>(i)), 0.0f);
+    input.emplace_back(0.0f, -std::pow(2.0f, static_cast<float>(i)));
+  }
+  expectPowerToDecibels(input);
+}
+
+TEST(SimdUtils, IndexesAboveThreshold) {
+  for (const auto size : {0, 7, 8, 29, 1024, 1037}) {
+    std::mt19937 generator(size);
+    std::uniform_real_distribution<float> distribution(-20.0f, 20.0f);
+    std::vector<float> data(size);
+    std::vector<uint8_t> mask((size + 7) / 8);
+    for (auto& value : data) {
+      value = distribution(generator);
+    }
+    for (auto& value : mask) {
+      value = generator();
+    }
+
+    std::vector<int> expected;
+    for (int i = 0; i < size; ++i) {
+      if ((mask[i / 8] >> (i % 8)) & 1 && 8.0f <= data[i]) {
+        expected.push_back(i);
+      }
+    }
+    std::vector<int> indexes(size);
+    indexes.resize(getIndexesAboveThreshold(data.data(), mask.data(), size, 8.0f, indexes.data()));
+    EXPECT_EQ(indexes, expected) << "size: " << size;
+  }
+}
+
+TEST(SimdUtils, ReplaceRowAndDivide) {
+  for (const auto size : {0, 3, 8, 29, 1037}) {
+    std::mt19937 generator(size);
+    std::uniform_int_distribution<int> distribution(-120, 20);
+    std::vector<float> sum(size), row(size), data(size), output(size);
+    for (int i = 0; i < size; ++i) {
+      row[i] = distribution(generator);
+      data[i] = distribution(generator);
+      sum[i] = row[i] + distribution(generator);
+    }
+    auto expected = sum;
+    for (int i = 0; i < size; ++i) {
+      expected[i] = expected[i] - row[i] + data[i];
+    }
+    replaceRow(sum.data(), row.data(), data.data(), size);
+    EXPECT_EQ(sum, expected);
+    EXPECT_EQ(row, data);
+
+    divide(sum.data(), output.data(), size, 3.0f);
+    for (int i = 0; i < size; ++i) {
+      EXPECT_EQ(output[i], sum[i] / 3.0f);
+    }
+  }
+}
+
+TEST(SimdUtils, TrackQuantile) {
+  for (const auto size : {0, 3, 8, 29, 1037}) {
+    std::mt19937 generator(size);
+    std::normal_distribution<float> distribution(-100.0f, 5.0f);
+    std::vector<float> estimate(size, -60.0f), data(size);
+    for (int i = 0; i < 4000; ++i) {
+      for (auto& value : data) {
+        value = distribution(generator);
+      }
+      auto expected = estimate;
+      for (int j = 0; j < size; ++j) {
+        expected[j] += data[j] < expected[j] ? -0.08f : 0.02f;
+      }
+      trackQuantile(estimate.data(), data.data(), size, 0.02f, 0.08f);
+      ASSERT_EQ(estimate, expected);
+    }
+    // 20th percentile of normal distribution is 0.84 sigma below mean
+    for (const auto value : estimate) {
+      EXPECT_NEAR(value, -100.0f - 0.84f * 5.0f, 1.5f);
+    }
+  }
+}
+
+TEST(SimdUtils, IntegerToFloat) {
+  for (const auto size : {0, 6, 16, 38, 1030}) {
+    std::vector<int8_t> input8(size);
+    std::vector<int16_t> input16(size);
+    for (int i = 0; i < size; ++i) {
+      input8[i] = static_cast<int8_t>(i * 37 - 128);
+      input16[i] = static_cast<int16_t>(i * 9973 - 32768);
+    }
+    std::vector<float> output8(size), output16(size);
+    int8ToFloat(input8.data(), output8.data(), size, 1.0f / 128.0f);
+    int16ToFloat(input16.data(), output16.data(), size, 1.0f / 32768.0f);
+    for (int i = 0; i < size; ++i) {
+      ASSERT_EQ(output8[i], input8[i] / 128.0f) << "index: " << i;
+      ASSERT_EQ(output16[i], input16[i] / 32768.0f) << "index: " << i;
+    }
+  }
+}
+
+TEST(SimdUtils, FloatToInt8) {
+  for (const auto size : {0, 7, 16, 45, 1041}) {
+    std::mt19937 generator(size);
+    std::uniform_real_distribution<float> distribution(-1.5f, 1.5f);
+    std::vector<float> input(size);
+    for (auto& value : input) {
+      value = distribution(generator);
+    }
+    std::vector<int8_t> output(size);
+    floatToInt8(input.data(), output.data(), size, 127.0f);
+    for (int i = 0; i < size; ++i) {
+      const auto expected = std::max(-128.0f, std::min(127.0f, std::round(input[i] * 127.0f)));
+      ASSERT_EQ(output[i], static_cast<int8_t>(expected)) << "index: " << i << ", value: " << input[i];
+    }
+  }
+  const std::vector<float> input = {1e10f, -1e10f, 0.0f, -0.0f, 0.4f, -0.6f, 126.6f, -127.6f, 128.0f, -129.0f, 5.0f, -5.0f, 1000.0f, -1000.0f, 0.6f, -0.4f};
+  std::vector<int8_t> output(input.size());
+  floatToInt8(input.data(), output.data(), input.size(), 1.0f);
+  EXPECT_EQ(output, std::vector<int8_t>({127, -128, 0, 0, 0, -1, 127, -128, 127, -128, 5, -5, 127, -128, 1, 0}));
+}
+
+TEST(SimdUtils, CopyXor) {
+  for (const auto size : {0, 5, 16, 32, 77, 1029}) {
+    std::vector<uint8_t> input(size);
+    for (int i = 0; i < size; ++i) {
+      input[i] = static_cast<uint8_t>(i * 31 + 7);
+    }
+    std::vector<uint8_t> output(size);
+    copyXor(input.data(), output.data(), size, 0x80);
+    for (int i = 0; i < size; ++i) {
+      ASSERT_EQ(output[i], static_cast<uint8_t>(input[i] ^ 0x80)) << "index: " << i;
+    }
+  }
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include <utils/snapshot.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(Snapshot, Swap) {
+  Snapshot<std::vector<int>> snapshot(std::make_shared<const std::vector<int>>(std::vector<int>{1, 2, 3}));
+  const auto previous = snapshot.load();
+  snapshot.store(std::make_shared<const std::vector<int>>(std::vector<int>{4, 5}));
+  EXPECT_EQ(*previous, std::vector<int>({1, 2, 3}));
+  EXPECT_EQ(*snapshot.load(), std::vector<int>({4, 5}));
+}
+
+TEST(Snapshot, ConcurrentReaders) {
+  constexpr auto UPDATES = 10000;
+  Snapshot<std::vector<int>> snapshot(std::make_shared<const std::vector<int>>(std::vector<int>(16, 0)));
+  std::atomic<bool> isRunning{true};
+  std::atomic<int> torn{0};
+  std::vector<std::thread> readers;
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&snapshot, &isRunning, &torn]() {
+      while (isRunning) {
+        const auto value = snapshot.load();
+        if (std::count(value->begin(), value->end(), value->front()) != static_cast<int>(value->size())) {
+          torn++;
+        }
+      }
+    });
+  }
+  for (int i = 1; i <= UPDATES; ++i) {
+    snapshot.store(std::make_shared<const std::vector<int>>(std::vector<int>(16, i)));
+  }
+  isRunning = false;
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_EQ(torn, 0);
+  EXPECT_EQ(snapshot.load()->front(), UPDATES);
+}
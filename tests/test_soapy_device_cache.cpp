@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <radio/soapy_device_cache.h>
+
+#include <cstdio>
+#include <filesystem>
+
+namespace {
+const SoapySDR::Kwargs ARGS = {{"driver", "rtlsdr"}, {"serial", "00000001"}, {"tuner", "Rafael Micro R820T"}};
+const nlohmann::json CAPABILITIES = {{"sample_rates", {1024000, 2048000}}, {"native_format", "CS8"}, {"full_scale", 128.0}};
+}  // namespace
+
+TEST(SoapyDeviceCache, GetStored) {
+  SoapyDeviceCache cache("");
+  EXPECT_FALSE(cache.get(ARGS).has_value());
+  cache.store(ARGS, CAPABILITIES);
+  ASSERT_TRUE(cache.get(ARGS).has_value());
+  EXPECT_EQ(*cache.get(ARGS), CAPABILITIES);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(SoapyDeviceCache, ChangedDevice) {
+  SoapyDeviceCache cache("");
+  cache.store(ARGS, CAPABILITIES);
+
+  auto changed = ARGS;
+  changed["tuner"] = "Rafael Micro R828D";
+  EXPECT_FALSE(cache.get(changed).has_value());
+
+  auto other = ARGS;
+  other["serial"] = "00000002";
+  EXPECT_FALSE(cache.get(other).has_value());
+
+  cache.store(changed, CAPABILITIES);
+  EXPECT_FALSE(cache.get(ARGS).has_value());
+  EXPECT_TRUE(cache.get(changed).has_value());
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(SoapyDeviceCache, PreviousOfChangedDevice) {
+  SoapyDeviceCache cache("");
+  EXPECT_FALSE(cache.getPrevious(ARGS).has_value());
+  cache.store(ARGS, CAPABILITIES);
+
+  auto changed = ARGS;
+  changed["available"] = "No";
+  EXPECT_FALSE(cache.get(changed).has_value());
+  ASSERT_TRUE(cache.getPrevious(changed).has_value());
+  EXPECT_EQ(*cache.getPrevious(changed), CAPABILITIES);
+
+  auto other = ARGS;
+  other["serial"] = "00000002";
+  EXPECT_FALSE(cache.getPrevious(other).has_value());
+}
+
+TEST(SoapyDeviceCache, File) {
+  const auto path = "test_devices.cache";
+  std::remove(path);
+  {
+    SoapyDeviceCache cache(path);
+    EXPECT_EQ(cache.size(), 0);
+    cache.store(ARGS, CAPABILITIES);
+  }
+  {
+    SoapyDeviceCache cache(path);
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(*cache.get(ARGS), CAPABILITIES);
+  }
+  EXPECT_FALSE(std::filesystem::exists(std::string(path) + ".tmp"));
+
+  FILE* file = fopen(path, "w");
+  fputs("{\"rtlsdr_00000001\": ", file);
+  fclose(file);
+  SoapyDeviceCache cache(path);
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_FALSE(cache.get(ARGS).has_value());
+  std::remove(path);
+}
@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+#include <utils/thread_utils.h>
+
+#include <sched.h>
+
+TEST(ThreadUtils, FormatCores) {
+  EXPECT_EQ(formatCores({}), "any");
+  EXPECT_EQ(formatCores({3}), "3");
+  EXPECT_EQ(formatCores({0, 2, 5}), "0,2,5");
+}
+
+TEST(ThreadUtils, Affinity) {
+  cpu_set_t original;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(original), &original), 0);
+
+  EXPECT_TRUE(setThreadAffinity(pthread_self(), {}));
+  EXPECT_FALSE(setThreadAffinity(pthread_self(), {-1}));
+  EXPECT_TRUE(setThreadAffinity(pthread_self(), {sched_getcpu()}));
+
+  cpu_set_t current;
+  ASSERT_EQ(pthread_getaffinity_np(pthread_self(), sizeof(current), &current), 0);
+  EXPECT_EQ(CPU_COUNT(&current), 1);
+  ASSERT_EQ(pthread_setaffinity_np(pthread_self(), sizeof(original), &original), 0);
+}
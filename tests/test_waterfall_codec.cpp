@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <utils/waterfall_codec.h>
+
+#include <random>
+#include <vector>
+
+constexpr auto SIZE = 1024;
+constexpr auto KEYFRAME_INTERVAL = 4;
+
+std::vector<int8_t> generateRow(std::mt19937& generator, const int noise) {
+  std::uniform_int_distribution<int> distribution(-noise, noise);
+  std::vector<int8_t> row(SIZE);
+  for (int i = 0; i < SIZE; ++i) {
+    row[i] = -90 + distribution(generator) + (500 <= i && i < 510 ? 60 : 0);
+  }
+  return row;
+}
+
+TEST(WaterfallCodec, RoundTrip) {
+  std::mt19937 generator(0);
+  WaterfallEncoder encoder(SIZE, KEYFRAME_INTERVAL);
+  WaterfallDecoder decoder(SIZE);
+  for (int i = 0; i < 10; ++i) {
+    const auto row = generateRow(generator, 3);
+    const auto data = encoder.encode(row.data());
+    EXPECT_EQ(data[0], i % KEYFRAME_INTERVAL == 0 ? 0 : 1);
+    EXPECT_LT(data.size(), SIZE / 2);
+
+    std::vector<int8_t> decoded(SIZE);
+    ASSERT_TRUE(decoder.decode(reinterpret_cast<const uint8_t*>(data.data()), data.size(), decoded.data()));
+    EXPECT_EQ(decoded, row);
+  }
+}
+
+TEST(WaterfallCodec, ExtremeValues) {
+  WaterfallEncoder encoder(SIZE, KEYFRAME_INTERVAL);
+  WaterfallDecoder decoder(SIZE);
+  for (int i = 0; i < 3; ++i) {
+    std::vector<int8_t> row(SIZE);
+    for (int j = 0; j < SIZE; ++j) {
+      row[j] = (i + j) % 2 ? -128 : 127;
+    }
+    const auto data = encoder.encode(row.data());
+    std::vector<int8_t> decoded(SIZE);
+    ASSERT_TRUE(decoder.decode(reinterpret_cast<const uint8_t*>(data.data()), data.size(), decoded.data()));
+    EXPECT_EQ(decoded, row);
+  }
+}
+
+TEST(WaterfallCodec, DeltaWithoutKeyframe) {
+  std::mt19937 generator(0);
+  WaterfallEncoder encoder(SIZE, KEYFRAME_INTERVAL);
+  WaterfallDecoder decoder(SIZE);
+  std::vector<int8_t> decoded(SIZE);
+  const auto keyframe = encoder.encode(generateRow(generator, 3).data());
+  const auto delta = encoder.encode(generateRow(generator, 3).data());
+  EXPECT_FALSE(decoder.decode(reinterpret_cast<const uint8_t*>(delta.data()), delta.size(), decoded.data()));
+  EXPECT_FALSE(decoder.decode(reinterpret_cast<const uint8_t*>(keyframe.data()), keyframe.size() / 2, decoded.data()));
+  EXPECT_TRUE(decoder.decode(reinterpret_cast<const uint8_t*>(keyframe.data()), keyframe.size(), decoded.data()));
+  EXPECT_TRUE(decoder.decode(reinterpret_cast<const uint8_t*>(delta.data()), delta.size(), decoded.data()));
+
+  encoder.reset();
+  EXPECT_EQ(encoder.encode(generateRow(generator, 3).data())[0], 0);
+}